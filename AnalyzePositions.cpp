@@ -0,0 +1,97 @@
+#include "PositionAnalysis.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//Read a setting given as name=value, e.g. level=8 or format=json. Returns false if the argument is not for this setting.
+bool readSetting(const std::string& argument, const std::string& name, std::string& value) {
+
+	if (argument.compare(0, name.size() + 1, name + "=") != 0) {
+		return false;
+	}
+
+	value = argument.substr(name.size() + 1);
+	return true;
+}
+
+bool readSetting(const std::string& argument, const std::string& name, int& value) {
+
+	std::string text;
+	if (!readSetting(argument, name, text)) {
+		return false;
+	}
+
+	value = std::atoi(text.c_str());
+	return true;
+}
+
+//Score every column of the positions in a file, one move string per line with an optional expected score, and write the
+//scores as CSV or JSON. Throughput and the share of expected scores found go to the error stream:
+//AnalyzePositions <positions file> [format=csv|json] [level=N] [solve=0|1] [rows=N] [columns=N]
+int main(int argc, char* argv[]) {
+
+	const std::string usage = " <positions file> [format=csv|json] [level=N] [solve=0|1] [rows=N] [columns=N]";
+	if (argc < 2) {
+		std::cout << "Usage: " << argv[0] << usage << std::endl;
+		return 1;
+	}
+
+	controller::PositionAnalysis::Settings settings;
+	std::string format = "csv";
+	for (int argumentIndex = 2; argumentIndex < argc; ++argumentIndex) {
+
+		std::string argument = argv[argumentIndex];
+		int solveExactly;
+		bool isKnownSetting = readSetting(argument, "format", format) || readSetting(argument, "level", settings.difficultyLevel) ||
+			readSetting(argument, "rows", settings.numberOfRows) || readSetting(argument, "columns", settings.numberOfColumns);
+		if (!isKnownSetting && readSetting(argument, "solve", solveExactly)) {
+			settings.solveExactly = solveExactly != 0;
+			isKnownSetting = true;
+		}
+
+		if (!isKnownSetting || (format != "csv" && format != "json")) {
+			std::cout << "Usage: " << argv[0] << usage << std::endl;
+			return 1;
+		}
+	}
+
+	if (settings.solveExactly && !controller::EndgameSolver::canSolve(settings.numberOfRows, settings.numberOfColumns)) {
+		std::cout << "Boards of " << settings.numberOfRows << " rows and " << settings.numberOfColumns << " columns cannot be solved exactly" << std::endl;
+		return 1;
+	}
+
+	std::ifstream positionsFile(argv[1]);
+	if (!positionsFile) {
+		std::cout << "Could not open " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::vector<controller::PositionAnalysis::Position> positions;
+	std::string line;
+	controller::PositionAnalysis::Position position;
+	while (std::getline(positionsFile, line)) {
+		if (controller::PositionAnalysis::readPosition(line, position)) {
+			positions.push_back(position);
+		}
+	}
+
+	controller::PositionAnalysis positionAnalysis(settings);
+	controller::PositionAnalysis::Results results = positionAnalysis.analyze(positions);
+	if (format == "json") {
+		positionAnalysis.writeJson(std::cout, results);
+	}
+	else {
+		positionAnalysis.writeCsv(std::cout, results);
+	}
+
+	std::cerr << "Positions: " << results.validPositions << " of " << positions.size() << " valid in " << results.wallTimeInSeconds << " s, " <<
+		results.getPositionsPerSecond() << " positions/s, " << results.nodesSearched << " nodes" << std::endl;
+	if (results.positionsWithExpectedScore > 0) {
+		std::cerr << "Expected scores found: " << 100.0 * results.exactScores / results.positionsWithExpectedScore << "%, outcomes found: " <<
+			100.0 * results.exactOutcomes / results.positionsWithExpectedScore << "%" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,203 @@
+#include "ConnectFourGame.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+typedef controller::ConnectFourGame::GameBoard GameBoard;
+
+const int NUMBER_OF_DIRECTIONS = 4;
+
+//Read a setting given as name=value, e.g. positions=500 or level=7. Returns false if the argument is not for this setting.
+bool readSetting(const std::string& argument, const std::string& name, int& value) {
+
+	if (argument.compare(0, name.size() + 1, name + "=") != 0) {
+		return false;
+	}
+
+	value = std::atoi(argument.c_str() + name.size() + 1);
+	return true;
+}
+
+//Score of the windows through a slot for the player who just dropped a coin in it, as the search scores a move
+int scoreWindows(const int* windowIndices, int numberOfWindows, const GameBoard& gameBoard, bool isUserCoin) {
+
+	const int scoresForCoinsInRow[] = { 0, 1, 3, 9, INT_MAX };
+	int totalScore = 0;
+	for (int windowCounter = 0; windowCounter < numberOfWindows; ++windowCounter) {
+
+		int windowIndex = windowIndices[windowCounter];
+		int ownCoins = isUserCoin ? gameBoard.getUserCoinsInWindow(windowIndex) : gameBoard.getComputerCoinsInWindow(windowIndex);
+		int opponentCoins = isUserCoin ? gameBoard.getComputerCoinsInWindow(windowIndex) : gameBoard.getUserCoinsInWindow(windowIndex);
+		if (opponentCoins == 0) {
+			if (scoresForCoinsInRow[ownCoins] == INT_MAX) {
+				return INT_MAX;
+			}
+			totalScore += scoresForCoinsInRow[ownCoins];
+		}
+	}
+
+	return totalScore;
+}
+
+int scoreDirection(int direction, int slot, const GameBoard& gameBoard, bool isUserCoin) {
+
+	int numberOfWindows;
+	const int* windowIndices = gameBoard.getWindowsContainingSlot(slot, direction, numberOfWindows);
+	return scoreWindows(windowIndices, numberOfWindows, gameBoard, isUserCoin);
+}
+
+int addDirectionalScores(const int directionalScores[]) {
+
+	int totalScore = 0;
+	for (int direction = 0; direction < NUMBER_OF_DIRECTIONS; ++direction) {
+		if (directionalScores[direction] == INT_MAX) {
+			return INT_MAX;
+		}
+		totalScore += directionalScores[direction];
+	}
+
+	return totalScore;
+}
+
+//The evaluation the search used before it took one pass over the windows: each direction scored on its own
+int scoreByDirection(int slot, const GameBoard& gameBoard, bool isUserCoin) {
+
+	int directionalScores[NUMBER_OF_DIRECTIONS];
+	for (int direction = 0; direction < NUMBER_OF_DIRECTIONS; ++direction) {
+		directionalScores[direction] = scoreDirection(direction, slot, gameBoard, isUserCoin);
+	}
+
+	return addDirectionalScores(directionalScores);
+}
+
+//The same in parallel mode, where a parallel_for over the columns had every chunk score all four directions again. The
+//scores are atomic here so that the chunks writing them at the same time do not race.
+int scoreByDirectionInParallel(int slot, const GameBoard& gameBoard, bool isUserCoin) {
+
+	std::atomic<int> sharedScores[NUMBER_OF_DIRECTIONS];
+	tbb::parallel_for(tbb::blocked_range<int>(0, gameBoard.getNumberOfColumns()), [&](const tbb::blocked_range<int>&) {
+		for (int direction = 0; direction < NUMBER_OF_DIRECTIONS; ++direction) {
+			sharedScores[direction].store(scoreDirection(direction, slot, gameBoard, isUserCoin), std::memory_order_relaxed);
+		}
+	});
+
+	int directionalScores[NUMBER_OF_DIRECTIONS];
+	for (int direction = 0; direction < NUMBER_OF_DIRECTIONS; ++direction) {
+		directionalScores[direction] = sharedScores[direction].load(std::memory_order_relaxed);
+	}
+
+	return addDirectionalScores(directionalScores);
+}
+
+//The evaluation the search uses now in both modes: one pass over the windows through the slot in every direction
+int scoreInOnePass(int slot, const GameBoard& gameBoard, bool isUserCoin) {
+
+	int numberOfWindows;
+	const int* windowIndices = gameBoard.getWindowsContainingSlot(slot, numberOfWindows);
+	return scoreWindows(windowIndices, numberOfWindows, gameBoard, isUserCoin);
+}
+
+//Evaluate every move on every position a number of times and report the time per evaluation. The sum of the scores
+//keeps the work from being optimized away and shows that the evaluations agree.
+template <typename Evaluation>
+void benchmarkEvaluation(const std::string& name, Evaluation evaluation, std::vector<GameBoard>& positions, int repeats) {
+
+	long long evaluations = 0, scoreSum = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; ++repeat) {
+		for (GameBoard& position : positions) {
+			for (int column = 0; column < position.getNumberOfColumns(); ++column) {
+				if (position.isValidPlay(column)) {
+					position.dropCoin(column, false);
+					scoreSum += evaluation(position.getPlayedSlot(column), position, false);
+					position.removeCoin(column);
+					++evaluations;
+				}
+			}
+		}
+	}
+	double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << name << ": " << nanoseconds / std::max(1LL, evaluations) << " ns per node over " << evaluations << " evaluations, score sum " <<
+		scoreSum << std::endl;
+}
+
+//Search every position and report the search time per node, which includes the evaluation
+void benchmarkSearch(bool parallelMode, int difficultyLevel, const std::vector<GameBoard>& positions) {
+
+	controller::ConnectFourGame connectFourGame;
+	connectFourGame.setgameDifficultyLevel(difficultyLevel);
+	connectFourGame.setComputationModeToParallel(parallelMode);
+	connectFourGame.setEndgameSolverThreshold(0);
+
+	long long nodesSearched = 0, evaluationCalls = 0;
+	double wallTimeInMilliseconds = 0;
+	for (const GameBoard& position : positions) {
+		connectFourGame.searchComputerMove(position);
+		const controller::ConnectFourGame::SearchStats& searchStats = connectFourGame.getSearchStatsForLastMove();
+		nodesSearched += searchStats.nodesSearched;
+		evaluationCalls += searchStats.evaluationCalls;
+		wallTimeInMilliseconds += searchStats.wallTimeInMilliseconds;
+	}
+
+	std::cout << (parallelMode ? "Parallel" : "Serial") << " search to level " << difficultyLevel << ": " << 1e6 * wallTimeInMilliseconds / std::max(1LL, nodesSearched) <<
+		" ns per node over " << nodesSearched << " nodes, " << static_cast<double>(evaluationCalls) / std::max(1LL, nodesSearched) << " evaluations per node" << std::endl;
+}
+
+//Measure the cost of evaluating a move per node, the way the search evaluated moves before and after it took one pass
+//over the windows through the dropped coin, and the search time per node in serial and parallel mode. The positions
+//come from random games with the computer to move, and are the same for the same seed:
+//BenchmarkEvaluation [positions=N] [seed=N] [repeats=N] [level=N]
+int main(int argc, char* argv[]) {
+
+	int numberOfPositions = 200, seed = 1, repeats = 50, difficultyLevel = 6;
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex) {
+
+		std::string argument = argv[argumentIndex];
+		if (!readSetting(argument, "positions", numberOfPositions) && !readSetting(argument, "seed", seed) && !readSetting(argument, "repeats", repeats) &&
+			!readSetting(argument, "level", difficultyLevel)) {
+			std::cout << "Usage: " << argv[0] << " [positions=N] [seed=N] [repeats=N] [level=N]" << std::endl;
+			return 1;
+		}
+	}
+
+	//Random games of an even number of coins that nobody has won yet
+	std::vector<GameBoard> positions;
+	std::mt19937 random(seed);
+	while (static_cast<int>(positions.size()) < numberOfPositions) {
+
+		GameBoard gameBoard;
+		int numberOfCoins = 2 * (2 + random() % 8);
+		bool isUserCoin = true, gameIsOver = false;
+		for (int coinCounter = 0; coinCounter < numberOfCoins && !gameIsOver; ++coinCounter) {
+			int column;
+			do {
+				column = random() % gameBoard.getNumberOfColumns();
+			} while (!gameBoard.isValidPlay(column));
+			gameBoard.dropCoin(column, isUserCoin);
+			gameIsOver = gameBoard.isWinningPlay(column);
+			isUserCoin = !isUserCoin;
+		}
+
+		if (!gameIsOver) {
+			positions.push_back(gameBoard);
+		}
+	}
+
+	benchmarkEvaluation("Before, serial", scoreByDirection, positions, repeats);
+	benchmarkEvaluation("Before, parallel", scoreByDirectionInParallel, positions, repeats);
+	benchmarkEvaluation("After, serial and parallel", scoreInOnePass, positions, repeats);
+	benchmarkSearch(false, difficultyLevel, positions);
+	benchmarkSearch(true, difficultyLevel, positions);
+	return 0;
+}
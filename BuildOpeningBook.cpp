@@ -0,0 +1,70 @@
+#include "ConnectFourGame.hpp"
+#include "GameBoard.hpp"
+#include "OpeningBook.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Constants for default values
+const int DEFAULT_NUMBER_OF_PLIES = 8;
+const int DEFAULT_SEARCH_DEPTH = 12;
+
+//Add the computer's move for every position the user can reach from this one, up to the required number of coins on the board.
+//The user moves first, so only the computer's best move is followed from each position it has to answer.
+void addBookMoves(controller::StandardConnectFourGame& connectFourGame, model::StandardGameBoard& gameBoard, int numberOfPlies,
+	std::vector<std::pair<std::uint64_t, int> >& bookEntries) {
+
+	for (int userMove = 0; userMove < gameBoard.getNumberOfColumns(); ++userMove) {
+
+		if (!gameBoard.isValidPlay(userMove)) {
+			continue;
+		}
+
+		gameBoard.dropCoin(userMove, true);
+		if (!gameBoard.isWinningPlay(userMove)) {
+
+			int computerMove = connectFourGame.searchComputerMove(gameBoard);
+			bookEntries.push_back(std::make_pair(gameBoard.getPositionHash(), computerMove));
+
+			gameBoard.dropCoin(computerMove, false);
+			if (!gameBoard.isWinningPlay(computerMove) && gameBoard.getNumberOfCoins() + 1 <= numberOfPlies) {
+				addBookMoves(connectFourGame, gameBoard, numberOfPlies, bookEntries);
+			}
+			gameBoard.removeCoin(computerMove);
+		}
+		gameBoard.removeCoin(userMove);
+	}
+}
+
+//Build the opening book for the standard board offline: BuildOpeningBook <book file> [number of plies] [search depth]
+//The book holds the computer's move for every position with at most the number of plies of coins on the board.
+int main(int argc, char* argv[]) {
+
+	if (argc < 2) {
+		std::cout << "Usage: " << argv[0] << " <book file> [number of plies, default " << DEFAULT_NUMBER_OF_PLIES << "] [search depth, default " << DEFAULT_SEARCH_DEPTH << "]" << std::endl;
+		return 1;
+	}
+
+	std::string bookFileName = argv[1];
+	int numberOfPlies = argc > 2 ? std::atoi(argv[2]) : DEFAULT_NUMBER_OF_PLIES;
+	int searchDepth = argc > 3 ? std::atoi(argv[3]) : DEFAULT_SEARCH_DEPTH;
+
+	controller::StandardConnectFourGame connectFourGame;
+	connectFourGame.setgameDifficultyLevel(searchDepth);
+
+	model::StandardGameBoard gameBoard;
+	std::vector<std::pair<std::uint64_t, int> > bookEntries;
+	addBookMoves(connectFourGame, gameBoard, numberOfPlies, bookEntries);
+
+	if (!controller::OpeningBook::write(bookFileName, gameBoard.getNumberOfRows(), gameBoard.getNumberOfColumns(), searchDepth, numberOfPlies, bookEntries)) {
+		std::cout << "Could not write the opening book to " << bookFileName << std::endl;
+		return 1;
+	}
+
+	std::cout << "Wrote " << bookEntries.size() << " positions searched to depth " << searchDepth << " to " << bookFileName << std::endl;
+	return 0;
+}
@@ -1,21 +1,75 @@
 #ifndef CONNECTFOURGAME
 #define CONNECTFOURGAME
 
-#include <tbb\blocked_range.h>
-#include <tbb\parallel_for.h>
+#include <tbb/task_group.h>
+#include <tbb/task_arena.h>
 
+#include "EndgameSolver.hpp"
 #include "GameBoard.hpp"
 #include "GameSlot.hpp"
+#include "MonteCarloTreeSearch.hpp"
+#include "OpeningBook.hpp"
+#include "TranspositionTable.hpp"
 
 #include <algorithm> 
+#include <atomic>
+#include <chrono>
 #include <climits>
+#include <cstdlib>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace controller {
 
-	class ConnectFourGame {
+	//Ways of finding the computer's moves: a minimax search with a heuristic score at the search depth, or Monte Carlo tree
+	//search, which plays games out to the end and sees further on large boards
+	enum class SearchEngine { minimax, monteCarloTreeSearch };
+
+	//Score ranges for the root of the minimax search: every score, a window around a guess at the score that is widened
+	//when the score falls outside it, or MTD(f), which closes in on the score with searches that only tell if the score
+	//is above or below a guess
+	enum class SearchWindow { full, aspiration, mtdf };
+
+	//Connect four game against the computer on a board with dimensions fixed at compile time, or given at run time
+	//when both template parameters are zero
+	template <int Rows = 0, int Columns = 0>
+	class BasicConnectFourGame {
+
+	public:
+
+		//Game board with the same fixed dimensions as the game
+		typedef model::BasicGameBoard<Rows, Columns> GameBoard;
+
+		//Work done by the search for a computer move. Evaluation calls are the heuristic scores worked out for the positions
+		//searched, and the nodes searched on each slot of the task arena show how evenly the work was spread across threads.
+		//Root searches count every search of the root board, including each depth of a search with a time budget and each
+		//search repeated with a wider window or a new guess.
+		struct SearchStats {
+			long long nodesSearched, evaluationCalls, cutoffs, tasksSpawned;
+			int maximumDepthReached, rootSearches;
+			double wallTimeInMilliseconds;
+			std::vector<long long> nodesSearchedPerThread;
+
+			SearchStats() : nodesSearched(0), evaluationCalls(0), cutoffs(0), tasksSpawned(0), maximumDepthReached(0), rootSearches(0), wallTimeInMilliseconds(0) {
+			}
+		};
+
+		//Analysis of one column for the computer. The principal variation starts with the column and goes on with the moves
+		//the search expects both players to make after it. The score is INT_MIN for a full column. On a board that is its own
+		//mirror image only one of each pair of mirrored columns is searched, so the other has no nodes searched of its own.
+		struct ColumnAnalysis {
+			bool isValid;
+			int score;
+			std::vector<int> principalVariation;
+			long long nodesSearched;
+		};
 
 	private:
 
@@ -23,548 +77,1518 @@ namespace controller {
 		const static bool DEFAULT_FIRST_PLAYER_IS_USER = true;
 		const static bool DEFAULT_MODE_IS_PARALLEL = true;
 		const static int DEFAULT_DIFFICULTY_LEVEL = 2;
+		const static bool DEFAULT_ALPHA_BETA_PRUNING_ENABLED = true;
+		const static bool DEFAULT_TRANSPOSITION_TABLE_ENABLED = true;
+		const static int DEFAULT_PARALLEL_SEARCH_DEPTH_CUTOFF = 3;
+		const static bool DEFAULT_CENTER_FIRST_MOVE_ORDERING_ENABLED = true;
+		const static bool DEFAULT_KILLER_MOVES_ENABLED = true;
+		const static bool DEFAULT_HISTORY_HEURISTIC_ENABLED = true;
+		const static bool DEFAULT_SYMMETRY_REDUCTION_ENABLED = true;
+		const static bool DEFAULT_THREAT_DETECTION_ENABLED = true;
+		const static bool DEFAULT_SEARCH_REUSE_ENABLED = true;
+		const static int KILLER_MOVES_PER_PLY = 2;
+		const static int DEFAULT_MOVE_TIME_BUDGET_IN_MILLISECONDS = 0;
+		const static int NODES_BETWEEN_DEADLINE_CHECKS = 1024;
+		const static bool DEFAULT_PONDERING_ENABLED = false;
+		const static int DEFAULT_ENDGAME_SOLVER_THRESHOLD = 22;
+		const static SearchEngine DEFAULT_SEARCH_ENGINE = SearchEngine::minimax;
+		const static int PLAYOUTS_PER_DIFFICULTY_LEVEL = 5000;
+		const static int CACHE_LINE_SIZE = 64;
+		const static std::uint64_t USER_TO_MOVE_KEY = 0xD1B54A32D192ED03ULL;
+		const static int PACKED_MOVE_RANGE = 256;
+		const static int MAXIMUM_NUMBER_OF_MOVES = PACKED_MOVE_RANGE - 1;
 		const static int HEURISTIC_SCORE_FOR_ONE_IN_ROW = 1;
 		const static int HEURISTIC_SCORE_FOR_TWO_IN_ROW = 3;
 		const static int HEURISTIC_SCORE_FOR_THREE_IN_ROW = 9;
 		const static int HEURISTIC_SCORE_FOR_FOUR_IN_ROW = INT_MAX;
+		const static SearchWindow DEFAULT_SEARCH_WINDOW = SearchWindow::aspiration;
+		const static int ASPIRATION_WINDOW_MARGIN = HEURISTIC_SCORE_FOR_TWO_IN_ROW;
 		const static int COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW = 3;
-		const static int HEURISTIC_SCORE_DIRECTIONS = 4;
 
-		int gameDifficultyLevel;
-		bool firstPlayerIsUser, gameModeIsParallel, gameIsOver, userWonTheGame;
-		model::GameBoard gameBoard;
+		int gameDifficultyLevel, parallelSearchDepthCutoff, moveTimeBudgetInMilliseconds, searchDepth, depthReached, endgameSolverThreshold;
+		bool firstPlayerIsUser, gameModeIsParallel, gameIsOver, userWonTheGame, alphaBetaPruningEnabled, transpositionTableEnabled;
+		bool centerFirstMoveOrderingEnabled, killerMovesEnabled, historyHeuristicEnabled, symmetryReductionEnabled, threatDetectionEnabled;
+		bool searchReuseEnabled;
+		SearchEngine searchEngine;
+		SearchWindow searchWindow;
+		int rootSearches;
+		GameBoard gameBoard;
+		TranspositionTable transpositionTable;
+
+		//Solver for positions close to the end of the game, made the first time it is needed
+		std::unique_ptr<EndgameSolver> endgameSolver;
+
+		//Monte Carlo tree search for the computer moves when it is the search engine, made the first time it is needed
+		std::unique_ptr<MonteCarloTreeSearch> monteCarloTreeSearch;
+
+		//Moves for the first positions of a game, found by deep searches ahead of time
+		OpeningBook openingBook;
+		std::atomic<long long> boardAllocations;
+
+		//Nodes searched so far by the current search for progress reports. Each thread adds its nodes in batches.
+		std::atomic<long long> nodesSearched;
+
+		//Set once the time budget for a move runs out or the search is cancelled so that every task of the search stops
+		std::atomic<bool> searchAborted, searchCancelled;
+		std::chrono::steady_clock::time_point searchDeadline;
+
+		//Statistics of the search for the last computer move
+		SearchStats searchStatsForLastMove;
+		long long boardAllocationsForLastMove;
+		std::vector<double> cutoffRatesForLastMove;
+		std::chrono::steady_clock::time_point searchStartTime;
+
+		//Computer reply worked out on the user's time for a position the user may move to, and the settings it was searched with
+		struct PonderedReply {
+			std::uint64_t positionKey;
+			int column, depthReached, gameDifficultyLevel, moveTimeBudgetInMilliseconds;
+		};
+
+		bool backgroundSearchStarted, computerToMove, lastMoveWasPondered;
+		std::atomic<bool> ponderingEnabled, ponderingInProgress, computerMoveInProgress;
+		std::atomic<int> depthCompletedInSearch;
+		GameBoard ponderingBoard;
+		std::vector<PonderedReply> ponderedReplies;
+
+		//Computer moves requested without waiting and pondering run on a task arena so that they do not hold up the thread that
+		//asked for them. The game has an arena of its own with no slots reserved for that thread, so worker threads pick up the
+		//work as soon as it is queued, but the search can be moved to an arena shared with the rest of a program.
+		tbb::task_arena defaultSearchArena;
+		tbb::task_arena* searchArena;
+		tbb::task_group backgroundSearchGroup;
+
+		//Boards used by the search on one worker thread. A deque keeps boards in place as it grows.
+		struct SearchBoardStack {
+			std::deque<GameBoard> boards;
+			size_t boardsInUse;
+		};
+
+		std::vector<SearchBoardStack> searchBoardStacks;
+
+		//Move ordering state shared by all tasks of a search. Killer moves are the last moves to cause a cutoff with a given
+		//number of plies left, and history scores grow each time a player's move in a column causes a cutoff.
+		std::vector<int> staticMoveOrder;
+		std::vector<std::atomic<int> > killerMoves, historyScores;
+
+		//Moves the search for the last computer move expects both players to make, starting with the computer's move, and the
+		//same moves as transposition table keys and moves for the positions they are played from
+		std::vector<int> principalVariationForLastMove;
+		std::vector<std::pair<std::uint64_t, int> > principalVariationEntries;
+
+		//Counters of the work done on one slot of the task arena during a search. Only the thread in the slot updates them, so
+		//they need no atomic operations, and the padding keeps the counters of neighbouring slots off the same cache line.
+		//The counts at each ply are for the positions searched and cut off that many plies below the root.
+		struct SearchThreadCounters {
+			long long nodesSearched, evaluationCalls, cutoffs, tasksSpawned;
+			int maximumDepthReached;
+			std::vector<long long> nodesAtPly, cutoffsAtPly;
+			char padding[CACHE_LINE_SIZE];
+		};
+
+		std::vector<SearchThreadCounters> searchThreadCounters;
 
-		//Get heuristic scores for the four possible directions
-		void getHueristicScores(int& horizontalHueristicScore, int& verticalHueristicScore, int& positiveSlopeHueristicScore, int& negativeSlopeHueristicScore, int columnPlayed, const model::GameBoard gameBoard, bool isUserCoin) {
+		//Check if the last play was a winning play
+		bool wasWinningPlay(int columnPlayed) {
+			return this->gameBoard.isWinningPlay(columnPlayed);
+		}
 
-			if (this->gameModeIsParallel) {
+		//End the game
+		void endTheGame(bool userWon) {			
+			this->gameIsOver = true;
+			this->userWonTheGame = userWon;
+		}
 
-				tbb::parallel_for(
-					tbb::blocked_range<int>(0, gameBoard.getNumberOfColumns()),
-					[=, &horizontalHueristicScore, &verticalHueristicScore, &positiveSlopeHueristicScore, &negativeSlopeHueristicScore](tbb::blocked_range<int> range) {
+		//Keep a score or search bound within the range of valid scores so that it can be negated without overflow
+		static int clampScore(long long score) {
 
-					for (int counter = 0; counter < HEURISTIC_SCORE_DIRECTIONS; ++counter) {
+			if (score > INT_MAX) {
+				return INT_MAX;
+			}
+			else if (score < -INT_MAX) {
+				return -INT_MAX;
+			}
+			else {
+				return static_cast<int>(score);
+			}
+		}
 
-						switch (counter) {
+		//Raise a value shared between parallel tasks if the new value is better
+		template <typename T>
+		static void raiseSharedScore(std::atomic<T>& sharedScore, T newScore) {
 
-						case 0:
-							horizontalHueristicScore = getHorizontalHueristicScore(columnPlayed, gameBoard, isUserCoin);
-							break;
+			T currentScore = sharedScore.load();
+			while (newScore > currentScore && !sharedScore.compare_exchange_weak(currentScore, newScore)) {
+			}
+		}
 
-						case 1:
-							verticalHueristicScore = getVerticalHueristicScore(columnPlayed, gameBoard, isUserCoin);
-							break;
+		//Pack a score and the column that achieved it into one value so that parallel tasks can keep both in one atomic.
+		//Higher scores pack to larger values and equal scores favour the lower column. Zero means no move was found.
+		static long long packScoreAndMove(int score, int column) {
+			return (static_cast<long long>(score) + INT_MAX) * PACKED_MOVE_RANGE + (PACKED_MOVE_RANGE - 1 - column);
+		}
 
-						case 2:
-							positiveSlopeHueristicScore = getPositiveSlopeHueristicScore(columnPlayed, gameBoard, isUserCoin);
-							break;
+		static int unpackScore(long long scoreAndMove) {
+			return static_cast<int>(scoreAndMove / PACKED_MOVE_RANGE - INT_MAX);
+		}
 
-						case 3:
-							negativeSlopeHueristicScore = getNegativeSlopeHueristicScore(columnPlayed, gameBoard, isUserCoin);
-							break;
+		static int unpackMove(long long scoreAndMove) {
+			int column = PACKED_MOVE_RANGE - 1 - static_cast<int>(scoreAndMove % PACKED_MOVE_RANGE);
+			return column < PACKED_MOVE_RANGE - 1 ? column : -1;
+		}
 
-						}
+		//Make sure every worker thread has enough boards for the search so that none are allocated while it runs
+		void prepareSearchBoards(const GameBoard& rootBoard, int maximumDepth) {
 
-					}
-				}
-				);
+			this->boardAllocations = 0;
 
+			//Each level of the search can leave one board in use on a thread while it waits for other tasks
+			size_t boardsPerThread = maximumDepth + 1;
+			//An arena that has work queued but no workers to spare borrows one more thread, which takes the slot after the last one
+			size_t numberOfThreads = tbb::this_task_arena::max_concurrency() + 1;
+			if (this->searchBoardStacks.size() < numberOfThreads) {
+				this->searchBoardStacks.resize(numberOfThreads);
 			}
-			else {
-				horizontalHueristicScore = getHorizontalHueristicScore(columnPlayed, gameBoard, isUserCoin);
-				verticalHueristicScore = getVerticalHueristicScore(columnPlayed, gameBoard, isUserCoin);
-				positiveSlopeHueristicScore = getPositiveSlopeHueristicScore(columnPlayed, gameBoard, isUserCoin);
-				negativeSlopeHueristicScore = getNegativeSlopeHueristicScore(columnPlayed, gameBoard, isUserCoin);
+
+			for (SearchBoardStack& searchBoardStack : this->searchBoardStacks) {
+				searchBoardStack.boardsInUse = 0;
+				while (searchBoardStack.boards.size() < boardsPerThread) {
+					searchBoardStack.boards.push_back(rootBoard);
+				}
 			}
 		}
 
-		//Check if the last play was a winning play
-		bool wasWinningPlay(int columnPlayed, bool isUserCoin) {
+		//Make sure a vector of values shared between tasks has at least the required size and set all of them to the same value
+		template <typename T>
+		static void resetSharedValues(std::vector<std::atomic<T> >& sharedValues, size_t requiredSize, T value) {
 
-			//Compute hueristic scores for horizontal, vertical and diagonal four coins in a row resulting from 
-			//coin being dropped in column
-			int horizontalHueristicScore, verticalHueristicScore, positiveSlopeHueristicScore, negativeSlopeHueristicScore;
-			getHueristicScores(horizontalHueristicScore, verticalHueristicScore, positiveSlopeHueristicScore, negativeSlopeHueristicScore, columnPlayed, this->gameBoard, isUserCoin);
-			//If it was a winning move, then return with indicator saying so
-			if (horizontalHueristicScore == INT_MAX ||
-				verticalHueristicScore == INT_MAX ||
-				positiveSlopeHueristicScore == INT_MAX ||
-				negativeSlopeHueristicScore == INT_MAX) {
+			if (sharedValues.size() < requiredSize) {
+				std::vector<std::atomic<T> >(requiredSize).swap(sharedValues);
+			}
 
-				return true;
+			for (std::atomic<T>& sharedValue : sharedValues) {
+				sharedValue.store(value, std::memory_order_relaxed);
+			}
+		}
+
+		//Clear the killer moves and history scores from the last search. With search reuse the killer moves are kept and the
+		//history scores halved, so the cutoffs of the last turn still count but less than those of this one.
+		void prepareMoveOrdering(int maximumDepth) {
+
+			size_t numberOfPlies = maximumDepth + 1;
+			int numberOfColumns = this->gameBoard.getNumberOfColumns();
+			if (this->searchReuseEnabled && this->killerMoves.size() >= numberOfPlies * KILLER_MOVES_PER_PLY && this->historyScores.size() >= 2u * numberOfColumns) {
+				for (std::atomic<int>& historyScore : this->historyScores) {
+					historyScore.store(historyScore.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+				}
 			}
 			else {
-				return false;
+				resetSharedValues(this->killerMoves, numberOfPlies * KILLER_MOVES_PER_PLY, -1);
+				resetSharedValues(this->historyScores, 2 * numberOfColumns, 0);
 			}
-		}
 
-		//End the game
-		void endTheGame(bool userWon) {			
-			this->gameIsOver = true;
-			this->userWonTheGame = userWon;
+			//Columns nearer the center are part of more four-in-a-row windows, so they are tried first
+			this->staticMoveOrder.resize(numberOfColumns);
+			for (int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter) {
+				this->staticMoveOrder[columnCounter] = columnCounter;
+			}
+			if (this->centerFirstMoveOrderingEnabled) {
+				std::stable_sort(this->staticMoveOrder.begin(), this->staticMoveOrder.end(), [=](int firstColumn, int secondColumn) {
+					return std::abs(2 * firstColumn - (numberOfColumns - 1)) < std::abs(2 * secondColumn - (numberOfColumns - 1));
+				});
+			}
 		}
 
-		int bestHeuristicScoreForOpponentMoveParallel(int depth, bool isUserCoin, const model::GameBoard gameBoard) {
-
-			//Do a map to find the move with the highest score
-			std::vector<int> moveScores(gameBoard.getNumberOfColumns());
+		int getHistoryScore(bool isUserCoin, int column) const {
+			return this->historyScores[(isUserCoin ? this->gameBoard.getNumberOfColumns() : 0) + column].load(std::memory_order_relaxed);
+		}
 
-			tbb::parallel_for(
-				tbb::blocked_range<int>(0, gameBoard.getNumberOfColumns()),
-				[=, &moveScores](tbb::blocked_range<int> range) {
+		//Check if a board is its own mirror image, so that a move and its mirror image are worth the same and only one of them
+		//needs to be searched. Boards with different hashes for the two orientations cannot be symmetric.
+		bool isSymmetricPosition(const GameBoard& gameBoard) const {
+			return this->symmetryReductionEnabled && gameBoard.getPositionHash() == gameBoard.getMirroredPositionHash() && gameBoard.isMirrorSymmetric();
+		}
 
-					for (int columnCounter = range.begin(); columnCounter != range.end(); ++columnCounter) {
-						if (gameBoard.isValidPlay(columnCounter)) {
-							model::GameBoard whatIfGameBoard{ gameBoard.getGameBoardVector(), this->gameBoard.getNumberOfRows(), this->gameBoard.getNumberOfColumns() };
-							whatIfGameBoard.forceDropCoin(columnCounter, isUserCoin);
-							moveScores.at(columnCounter) = getMoveHueristicScore(depth, columnCounter, isUserCoin, whatIfGameBoard);
-						}
-						else {
-							moveScores.at(columnCounter) = -1 * INT_MAX;
-						}
-					}
-				}
-			);
+		//Replace each move to the right of the middle of a symmetric board by its mirror image, unless that is already in
+		//the list, and return how many moves are left. The moves keep their order.
+		static int removeMirroredMoves(const GameBoard& gameBoard, int orderedMoves[], int numberOfMoves) {
 
-			int bestScore = -1 * INT_MAX;
-			for (int moveCounter = 0; moveCounter < gameBoard.getNumberOfColumns(); ++moveCounter) {
-				if (moveScores.at(moveCounter) > bestScore) {
-					bestScore = moveScores.at(moveCounter);
+			int numberOfMovesLeft = 0;
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+				int move = std::min(orderedMoves[moveCounter], gameBoard.getMirroredColumn(orderedMoves[moveCounter]));
+				if (std::find(orderedMoves, orderedMoves + numberOfMovesLeft, move) == orderedMoves + numberOfMovesLeft) {
+					orderedMoves[numberOfMovesLeft++] = move;
 				}
 			}
 
-			return bestScore;
-
+			return numberOfMovesLeft;
 		}
 
-		int bestHeuristicScoreForOpponentMoveSeries(int depth, bool isUserCoin, const model::GameBoard gameBoard) {
-
-			int currentScore, bestScore = -1 * INT_MAX;
-			for (int columnCounter = 0; columnCounter < gameBoard.getNumberOfColumns(); ++columnCounter) {
+		//Check if a search this many plies deep sees the opponent's reply to a move, so that a move that lets the opponent win
+		//with their next coin is known to lose without searching it
+		bool detectsThreats(int depth) const {
+			return this->threatDetectionEnabled && depth >= 2;
+		}
 
-				if (gameBoard.isValidPlay(columnCounter)) {
-					//Make a copy of the current gameboard to simulate a dropped coin
-					model::GameBoard whatIfGameBoard{ gameBoard.getGameBoardVector(), this->gameBoard.getNumberOfRows(), this->gameBoard.getNumberOfColumns() };
-					whatIfGameBoard.forceDropCoin(columnCounter, isUserCoin);
+		//Leave out the moves that let the opponent win with their next coin and return how many moves are left. If the opponent
+		//can already win somewhere, only blocking them is worth searching. If every move loses, the first one is kept.
+		static int removeLosingMoves(bool isUserCoin, const GameBoard& gameBoard, int orderedMoves[], int numberOfMoves) {
 
-					currentScore = getMoveHueristicScore(depth, columnCounter, isUserCoin, whatIfGameBoard);
-					if (currentScore > bestScore) {
-						bestScore = currentScore;
-					}
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+				if (gameBoard.isWinningDrop(orderedMoves[moveCounter], !isUserCoin)) {
+					orderedMoves[0] = orderedMoves[moveCounter];
+					return 1;
+				}
+			}
 
+			int numberOfMovesLeft = 0;
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+				if (!gameBoard.givesOpponentWinAbove(orderedMoves[moveCounter], isUserCoin)) {
+					orderedMoves[numberOfMovesLeft++] = orderedMoves[moveCounter];
 				}
 			}
 
-			return bestScore;
+			return numberOfMovesLeft > 0 ? numberOfMovesLeft : std::min(numberOfMoves, 1);
 		}
 
-		//Compute best heuristic score for opponent move
-		int bestHeuristicScoreForOpponentMove(int depth, bool isUserCoin, const model::GameBoard gameBoard) {
+		//Check if the player can win with their next coin. A search this many plies deep would find the win straight away.
+		bool hasWinningDrop(int depth, bool isUserCoin, const GameBoard& gameBoard) const {
 
-			if (this->gameModeIsParallel) {
-				return bestHeuristicScoreForOpponentMoveParallel(depth, isUserCoin, gameBoard);
+			if (!this->threatDetectionEnabled || depth < 1) {
+				return false;
 			}
-			else {
-				return bestHeuristicScoreForOpponentMoveSeries(depth, isUserCoin, gameBoard);
+
+			for (int column = 0; column < gameBoard.getNumberOfColumns(); ++column) {
+				if (gameBoard.isWinningDrop(column, isUserCoin)) {
+					return true;
+				}
 			}
 
+			return false;
 		}
 
-		//Compute and return the hueristic score for the move
-		int getMoveHueristicScore(int depth, int columnPlayed, bool isUserCoin, model::GameBoard gameBoard) {
+		//Fill in the valid moves in the order they should be searched and return how many there are. The move suggested by
+		//the transposition table goes first, then the killer moves for this many plies left and then the rest of the moves
+		//by history score. Moves with the same history score keep the static order. Only one of each pair of mirrored moves
+		//is left on a symmetric board, and moves that let the opponent win straight away are left out.
+		int getOrderedMoves(int depth, bool isUserCoin, const GameBoard& gameBoard, int firstMove, int orderedMoves[]) const {
 
-			//If maximum depth has been reached, then return
-			if (depth == 0) {
-				return 0;
+			int numberOfMoves = 0;
+			if (gameBoard.isValidPlay(firstMove)) {
+				orderedMoves[numberOfMoves++] = firstMove;
 			}
 
-			//Compute hueristic scores for horizontal, vertical and diagonal four coins in a row resulting from 
-			//coin being dropped in column
-			int horizontalHueristicScore, verticalHueristicScore, positiveSlopeHueristicScore, negativeSlopeHueristicScore;
-			getHueristicScores(horizontalHueristicScore, verticalHueristicScore, positiveSlopeHueristicScore, negativeSlopeHueristicScore, columnPlayed, gameBoard, isUserCoin);
-
-			//If it was a winning move, then return with indicator saying so
-			if (horizontalHueristicScore == INT_MAX ||
-				verticalHueristicScore == INT_MAX ||
-				positiveSlopeHueristicScore == INT_MAX ||
-				negativeSlopeHueristicScore == INT_MAX) {
-
-				return INT_MAX;
+			if (this->killerMovesEnabled) {
+				for (int killerCounter = 0; killerCounter < KILLER_MOVES_PER_PLY; ++killerCounter) {
+					int killerMove = this->killerMoves[depth * KILLER_MOVES_PER_PLY + killerCounter].load(std::memory_order_relaxed);
+					if (gameBoard.isValidPlay(killerMove) && std::find(orderedMoves, orderedMoves + numberOfMoves, killerMove) == orderedMoves + numberOfMoves) {
+						orderedMoves[numberOfMoves++] = killerMove;
+					}
+				}
 			}
 
-			int heuristicScoreForCurrentMove = horizontalHueristicScore +
-				verticalHueristicScore +
-				positiveSlopeHueristicScore +
-				negativeSlopeHueristicScore;
+			int firstSortedMove = numberOfMoves;
+			for (int column : this->staticMoveOrder) {
+				if (gameBoard.isValidPlay(column) && std::find(orderedMoves, orderedMoves + firstSortedMove, column) == orderedMoves + firstSortedMove) {
 
-			int bestOpponentMoveScore = bestHeuristicScoreForOpponentMove(depth - 1, isUserCoin ? false : true, gameBoard);
+					//Insert the move after every move with a history score at least as high
+					int moveCounter = numberOfMoves++;
+					if (this->historyHeuristicEnabled) {
+						int historyScore = getHistoryScore(isUserCoin, column);
+						for (; moveCounter > firstSortedMove && getHistoryScore(isUserCoin, orderedMoves[moveCounter - 1]) < historyScore; --moveCounter) {
+							orderedMoves[moveCounter] = orderedMoves[moveCounter - 1];
+						}
+					}
+					orderedMoves[moveCounter] = column;
+				}
+			}
 
-			if (bestOpponentMoveScore == INT_MAX || bestOpponentMoveScore == -INT_MAX) {
-				return -1 * bestOpponentMoveScore;
+			if (isSymmetricPosition(gameBoard)) {
+				numberOfMoves = removeMirroredMoves(gameBoard, orderedMoves, numberOfMoves);
 			}
-			else {
-				return heuristicScoreForCurrentMove - bestOpponentMoveScore;
+			if (detectsThreats(depth)) {
+				numberOfMoves = removeLosingMoves(isUserCoin, gameBoard, orderedMoves, numberOfMoves);
 			}
-			 
-		}
-
-		//Check if the cells between from and to index are of the required type or empty. 
-		//Also count the number of cells of the required type.
-		bool isEmptyOrRequiredType(int fromIndex, int toIndex, bool userCoinPlayed, int& hueristicScore, model::GameBoard gameBoard) {
 
-			int coinCount = 0, nextRow, nextColumn, nextIndex;
-			bool firstTime = true;
+			return numberOfMoves;
+		}
 
-			int fromRow = gameBoard.getRowNumber(fromIndex);
-			int fromColumn = gameBoard.getColumnNumber(fromIndex);
-			int toRow = gameBoard.getRowNumber(toIndex);
-			int toColumn = gameBoard.getColumnNumber(toIndex);
+		//Remember a move that caused a cutoff so that it is tried early in other positions
+		void recordCutoffMove(int depth, bool isUserCoin, int column) {
 
-			for (int counter = 0; counter <= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW; ++counter) {
+			std::atomic<int>* killerMovesAtDepth = &this->killerMoves[depth * KILLER_MOVES_PER_PLY];
+			if (killerMovesAtDepth[0].load(std::memory_order_relaxed) != column) {
+				killerMovesAtDepth[1].store(killerMovesAtDepth[0].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				killerMovesAtDepth[0].store(column, std::memory_order_relaxed);
+			}
 
-				if (fromRow == toRow) {//horizontal sequence
-					nextRow = fromRow;
-					nextColumn = fromColumn + counter;
-					nextIndex = gameBoard.getBoardIndex(nextRow, nextColumn);
-				}
-				else if (fromColumn == toColumn) {//vertical sequence
-					nextRow = fromRow + counter;
-					nextColumn = fromColumn;
-					nextIndex = gameBoard.getBoardIndex(nextRow, nextColumn);
-				}
-				else if (fromRow > toRow && fromColumn < toColumn) {//diagonal going up
-					if (firstTime) {
-						firstTime = false;
-						nextIndex = fromIndex;
-					}
-					else {
-						nextIndex = gameBoard.getDiagonalCellToRightGoingUp(nextIndex);
-					}
+			//Cutoffs further from the leaves save more work, so they count for more
+			this->historyScores[(isUserCoin ? this->gameBoard.getNumberOfColumns() : 0) + column].fetch_add(depth * depth, std::memory_order_relaxed);
+		}
 
-				}
-				else if (fromRow < toRow && fromColumn < toColumn) {//diagonal going down
-					if (firstTime) {
-						firstTime = false;
-						nextIndex = fromIndex;
-					}
-					else {
-						nextIndex = gameBoard.getDiagonalCellToRightGoingDown(nextIndex);
-					}
+		//Slot of the current thread in the task arena. A thread that has not started any parallel work yet takes the first slot.
+		static int getSearchThreadIndex() {
+			return std::max(0, tbb::this_task_arena::current_thread_index());
+		}
 
-				}
+		//Clear the counters of every thread before a search that goes no deeper than the maximum depth
+		void prepareSearchCounters(int maximumDepth) {
 
-				if (gameBoard.getGameSlot(nextIndex).hasComputerCoin()) {
-					if (userCoinPlayed) {
-						return false;
-					}
-					else {
-						++coinCount;
-					}
-				}
-				else if (gameBoard.getGameSlot(nextIndex).hasUserCoin()) {
-					if (userCoinPlayed) {
-						++coinCount;
-					}
-					else {
-						return false;
-					}
-				}
+			this->nodesSearched = 0;
+			this->rootSearches = 0;
+			this->searchStartTime = std::chrono::steady_clock::now();
 
+			//An arena that has work queued but no workers to spare borrows one more thread, which takes the slot after the last one
+			size_t numberOfThreads = tbb::this_task_arena::max_concurrency() + 1;
+			if (this->searchThreadCounters.size() < numberOfThreads) {
+				this->searchThreadCounters.resize(numberOfThreads);
 			}
 
-			if (coinCount == 1) {
-				hueristicScore = HEURISTIC_SCORE_FOR_ONE_IN_ROW;
-			}
-			else if (coinCount == 2) {
-				hueristicScore = HEURISTIC_SCORE_FOR_TWO_IN_ROW;
-			}
-			else if (coinCount == 3) {
-				hueristicScore = HEURISTIC_SCORE_FOR_THREE_IN_ROW;
-			}
-			else if (coinCount == 4) {
-				hueristicScore = HEURISTIC_SCORE_FOR_FOUR_IN_ROW;
-			}
-			else {
-				hueristicScore = 0;
+			for (SearchThreadCounters& searchThreadCounters : this->searchThreadCounters) {
+				searchThreadCounters.nodesSearched = 0;
+				searchThreadCounters.evaluationCalls = 0;
+				searchThreadCounters.cutoffs = 0;
+				searchThreadCounters.tasksSpawned = 0;
+				searchThreadCounters.maximumDepthReached = 0;
+				searchThreadCounters.nodesAtPly.assign(maximumDepth + 1, 0);
+				searchThreadCounters.cutoffsAtPly.assign(maximumDepth + 1, 0);
 			}
+		}
 
-			return true;
+		SearchThreadCounters& getSearchThreadCounters() {
+			return this->searchThreadCounters[getSearchThreadIndex()];
 		}
 
-		//Heuristic score for dropping a coin in the column played for all potential four-in-a-row horizontal configurations.
-		int getHorizontalHueristicScore(int columnPlayed, model::GameBoard gameBoard, bool isUserCoin) {
+		//Take a board from the current thread's stack and set it to the position passed in. A thread only resumes a task
+		//it had to wait on once the tasks it picked up in the meantime are done, so boards are returned in stack order.
+		GameBoard& acquireSearchBoard(const GameBoard& position) {
 
-			int slidingWindowStartPosition, hueristicScore, totalHueristicScore = 0, endColumn;
-			if (columnPlayed >= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW) {
-				slidingWindowStartPosition = columnPlayed - COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
+			SearchBoardStack& searchBoardStack = this->searchBoardStacks[getSearchThreadIndex()];
+			if (searchBoardStack.boardsInUse == searchBoardStack.boards.size()) {
+				searchBoardStack.boards.push_back(position);
+				++this->boardAllocations;
 			}
 			else {
-				slidingWindowStartPosition = 0;
+				searchBoardStack.boards[searchBoardStack.boardsInUse] = position;
 			}
 
-			//Consider each four-in-a-row window starting from three before dropped column and ending at the dropped position
-			for (int startColumn = slidingWindowStartPosition; startColumn <= columnPlayed; ++startColumn) {
+			return searchBoardStack.boards[searchBoardStack.boardsInUse++];
+		}
 
-				if (startColumn + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW > gameBoard.getNumberOfColumns() - 1) {
-					break;
-				}
-				else {
-					endColumn = startColumn + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-				}
+		//Give back the board most recently taken by the current thread
+		void releaseSearchBoard() {
+			--this->searchBoardStacks[getSearchThreadIndex()].boardsInUse;
+		}
 
-				int rowContainingDroppedCoin = gameBoard.getRowNumber(gameBoard.getPlayedSlot(columnPlayed));
-				if (isEmptyOrRequiredType(gameBoard.getBoardIndex(rowContainingDroppedCoin, startColumn), gameBoard.getBoardIndex(rowContainingDroppedCoin, endColumn), isUserCoin, hueristicScore, gameBoard)) {
-					if (hueristicScore == INT_MAX) {
-						return INT_MAX;
-					}
-					else {
-						totalHueristicScore += hueristicScore;
-					}
-				}
+		//Check if the rest of the moves at this level can be skipped because the opponent will avoid this position
+		bool isCutoff(int alpha, int beta) const {
+			return this->alphaBetaPruningEnabled && alpha >= beta;
+		}
+
+		//Transposition table key for a position and the player about to move
+		static std::uint64_t getPositionKey(const GameBoard& gameBoard, bool isUserCoin) {
+
+			std::uint64_t positionKey = gameBoard.getPositionHash();
+			if (isUserCoin) {
+				positionKey ^= USER_TO_MOVE_KEY;
 			}
+			return positionKey;
+		}
 
-			return totalHueristicScore;
+		//Transposition table key for a position and the player about to move. With symmetry reduction on, a position and its
+		//mirror image share the key of whichever of them hashes lower, and isMirrored is set if that is the mirror image.
+		std::uint64_t getTranspositionKey(const GameBoard& gameBoard, bool isUserCoin, bool& isMirrored) const {
+
+			isMirrored = this->symmetryReductionEnabled && gameBoard.getMirroredPositionHash() < gameBoard.getPositionHash();
+			std::uint64_t positionKey = isMirrored ? gameBoard.getMirroredPositionHash() : gameBoard.getPositionHash();
+			if (isUserCoin) {
+				positionKey ^= USER_TO_MOVE_KEY;
+			}
+			return positionKey;
 		}
 
-		//Heuristic score for dropping a coin in the column played for all potential four-in-a-row vertical configurations.
-		int getVerticalHueristicScore(int columnPlayed, model::GameBoard gameBoard, bool isUserCoin) {
+		//Moves are stored in the transposition table for the orientation of the board the key came from, so a move for a
+		//mirrored key is mirrored on the way in and on the way out
+		static int getTranspositionMove(const GameBoard& gameBoard, int move, bool isMirrored) {
+			return isMirrored && move >= 0 ? gameBoard.getMirroredColumn(move) : move;
+		}
 
-			int slidingWindowStartPosition, hueristicScore, totalHueristicScore = 0, endRow;
-			int coinDroppedInRow = gameBoard.getRowNumber(gameBoard.getPlayedSlot(columnPlayed));
+		//Score one move for the player on a board of its own and raise the best score and move shared between parallel tasks
+		void searchMoveInParallelTask(int depth, int columnPlayed, bool isUserCoin, const GameBoard& gameBoard, int alpha, int beta, std::atomic<long long>& bestScoreAndMove) {
 
-			if (coinDroppedInRow >= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW) {
-				slidingWindowStartPosition = coinDroppedInRow - COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
+			//Skip the move if a brother has already found a score the opponent will avoid or the search has run out of time
+			int currentAlpha = std::max(alpha, unpackScore(bestScoreAndMove.load()));
+			if (isCutoff(currentAlpha, beta) || this->searchAborted.load(std::memory_order_relaxed)) {
+				return;
 			}
-			else {
-				slidingWindowStartPosition = 0;
+
+			GameBoard& whatIfGameBoard = acquireSearchBoard(gameBoard);
+			whatIfGameBoard.dropCoin(columnPlayed, isUserCoin);
+			int currentScore = getMoveHueristicScore(depth, columnPlayed, isUserCoin, whatIfGameBoard, currentAlpha, beta);
+			releaseSearchBoard();
+
+			raiseSharedScore(bestScoreAndMove, packScoreAndMove(currentScore, columnPlayed));
+		}
+
+		//Search the first move on its own and only then the rest of the moves in parallel (Young Brothers Wait). The first move
+		//is usually the best one, so its score lets the younger brothers prune, and if it causes a cutoff nothing is spawned.
+		int bestHeuristicScoreForOpponentMoveParallel(int depth, bool isUserCoin, GameBoard& gameBoard, int alpha, int beta, int firstMove, int& bestMove) {
+
+			int orderedMoves[MAXIMUM_NUMBER_OF_MOVES];
+			int numberOfMoves = getOrderedMoves(depth, isUserCoin, gameBoard, firstMove, orderedMoves);
+			if (numberOfMoves == 0) {
+				bestMove = -1;
+				return -1 * INT_MAX;
 			}
 
-			//Consider each four-in-a-row window in the vertical column
-			for (int startRow = slidingWindowStartPosition; startRow <= coinDroppedInRow; ++startRow) {
+			int eldestMove = orderedMoves[0];
 
-				if (startRow + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW > gameBoard.getNumberOfRows() - 1) {
-					break;
-				}
-				else {
-					endRow = startRow + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-				}
+			gameBoard.dropCoin(eldestMove, isUserCoin);
+			int eldestScore = getMoveHueristicScore(depth, eldestMove, isUserCoin, gameBoard, alpha, beta);
+			gameBoard.removeCoin(eldestMove);
 
-				if (isEmptyOrRequiredType(gameBoard.getBoardIndex(startRow, columnPlayed), gameBoard.getBoardIndex(endRow, columnPlayed), isUserCoin, hueristicScore, gameBoard)) {
-					if (hueristicScore == INT_MAX) {
-						return INT_MAX;
-					}
-					else {
-						totalHueristicScore += hueristicScore;
-					}
+			std::atomic<long long> bestScoreAndMove(packScoreAndMove(eldestScore, eldestMove));
+			if (!isCutoff(std::max(alpha, eldestScore), beta)) {
+
+				//The board is left alone while the younger brothers run since each of them starts from a copy of it
+				tbb::task_group youngerBrothersGroup;
+				getSearchThreadCounters().tasksSpawned += numberOfMoves - 1;
+				for (int moveCounter = 1; moveCounter < numberOfMoves; ++moveCounter) {
+					int columnCounter = orderedMoves[moveCounter];
+					youngerBrothersGroup.run([=, &bestScoreAndMove, &gameBoard] {
+						searchMoveInParallelTask(depth, columnCounter, isUserCoin, gameBoard, alpha, beta, bestScoreAndMove);
+					});
 				}
+				youngerBrothersGroup.wait();
 			}
 
-			return totalHueristicScore;
+			bestMove = unpackMove(bestScoreAndMove.load());
+			return unpackScore(bestScoreAndMove.load());
+
 		}
 
-		int getPositiveSlopeHueristicScore(int columnPlayed, model::GameBoard gameBoard, bool isUserCoin) {
+		int bestHeuristicScoreForOpponentMoveSeries(int depth, bool isUserCoin, GameBoard& gameBoard, int alpha, int beta, int firstMove, int& bestMove) {
 
-			int slidingWindowStartRowPosition, slidingWindowStartColumnPosition, hueristicScore, totalHueristicScore = 0, endRow, endColumn;
-			int coinDroppedInRow = gameBoard.getRowNumber(gameBoard.getPlayedSlot(columnPlayed));
+			int currentScore, bestScore = -1 * INT_MAX;
+			bestMove = -1;
+
+			//Try the moves most likely to cause a cutoff first
+			int orderedMoves[MAXIMUM_NUMBER_OF_MOVES];
+			int numberOfMoves = getOrderedMoves(depth, isUserCoin, gameBoard, firstMove, orderedMoves);
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+
+				//Simulate a dropped coin and take it back once the move is scored
+				int columnCounter = orderedMoves[moveCounter];
+				gameBoard.dropCoin(columnCounter, isUserCoin);
+				currentScore = getMoveHueristicScore(depth, columnCounter, isUserCoin, gameBoard, alpha, beta);
+				gameBoard.removeCoin(columnCounter);
+				if (currentScore > bestScore) {
+					bestScore = currentScore;
+					bestMove = columnCounter;
+					alpha = std::max(alpha, bestScore);
+				}
 
-			if (gameBoard.getNumberOfRows() - 1 - coinDroppedInRow >= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW && columnPlayed >= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW) {
-				//If you can go three down and left to start
-				slidingWindowStartRowPosition = coinDroppedInRow + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-				slidingWindowStartColumnPosition = columnPlayed - COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
+				//The opponent already has a better alternative earlier in the tree
+				if (isCutoff(alpha, beta) || this->searchAborted.load(std::memory_order_relaxed)) {
+					break;
+				}
 			}
-			else {
-				//You can only got the minimum of two values down and left
-				int rowDistanceFromBottom = gameBoard.getNumberOfRows() - 1 - coinDroppedInRow;
-				int columnDistanceFromLeft = columnPlayed;
 
-				slidingWindowStartRowPosition = coinDroppedInRow + std::min(rowDistanceFromBottom, columnDistanceFromLeft);
-				slidingWindowStartColumnPosition = columnPlayed - std::min(rowDistanceFromBottom, columnDistanceFromLeft);
+			return bestScore;
+		}
+
+		//Compute best heuristic score for opponent move. Scores at or below alpha and at or above beta only need to be bounds.
+		int bestHeuristicScoreForOpponentMove(int depth, bool isUserCoin, GameBoard& gameBoard, int alpha, int beta) {
+
+			//A coin that wins straight away is the best move there is, so nothing else needs to be searched
+			if (hasWinningDrop(depth, isUserCoin, gameBoard)) {
+				return INT_MAX;
 			}
 
-			//Consider each four-in-a-row window starting from three before dropped column and ending at the dropped position
-			for (int startRow = slidingWindowStartRowPosition, startColumn = slidingWindowStartColumnPosition; startColumn <= columnPlayed; --startRow, ++startColumn) {
+			//Positions at the last level are not worth storing since all their moves score zero
+			bool useTranspositionTable = this->transpositionTableEnabled && depth > 0, isMirrored;
+			std::uint64_t positionKey = getTranspositionKey(gameBoard, isUserCoin, isMirrored);
 
-				if (startColumn + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW > gameBoard.getNumberOfColumns() - 1 ||
-					startRow < COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW) {
-					break;
-				}
-				else {
-					endRow = startRow - COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-					endColumn = startColumn + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-				}
+			//Reuse the result of an earlier search of the same position, or its mirror image, if it was at least as deep
+			TranspositionTable::Entry entry;
+			int firstMove = -1;
+			if (useTranspositionTable && this->transpositionTable.lookup(positionKey, entry)) {
 
-				if (isEmptyOrRequiredType(gameBoard.getBoardIndex(startRow, startColumn), gameBoard.getBoardIndex(endRow, endColumn), isUserCoin, hueristicScore, gameBoard)) {
-					if (hueristicScore == INT_MAX) {
-						return INT_MAX;
+				firstMove = getTranspositionMove(gameBoard, entry.bestMove, isMirrored);
+				if (entry.depth >= depth) {
+					if (entry.boundType == TranspositionTable::BoundType::exact) {
+						return entry.score;
+					}
+					else if (entry.boundType == TranspositionTable::BoundType::lowerBound) {
+						alpha = std::max(alpha, entry.score);
 					}
 					else {
-						totalHueristicScore += hueristicScore;
+						beta = std::min(beta, entry.score);
+					}
+
+					if (isCutoff(alpha, beta)) {
+						return entry.score;
 					}
 				}
 			}
 
-			return totalHueristicScore;
-		}
-
-		int getNegativeSlopeHueristicScore(int columnPlayed, model::GameBoard gameBoard, bool isUserCoin) {
-
-			int slidingWindowStartRowPosition, slidingWindowStartColumnPosition, hueristicScore, totalHueristicScore = 0, endRow, endColumn;
-			int coinDroppedInRow = gameBoard.getRowNumber(gameBoard.getPlayedSlot(columnPlayed));
-
-			if (coinDroppedInRow >= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW && columnPlayed >= COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW) {
-				slidingWindowStartRowPosition = coinDroppedInRow - COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-				slidingWindowStartColumnPosition = columnPlayed - COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
+			//Subtrees close to the leaves are too small to be worth spreading across tasks
+			int bestScore, bestMove;
+			if (this->gameModeIsParallel && depth >= this->parallelSearchDepthCutoff) {
+				bestScore = bestHeuristicScoreForOpponentMoveParallel(depth, isUserCoin, gameBoard, alpha, beta, firstMove, bestMove);
 			}
 			else {
-				int rowDistanceFromTop = coinDroppedInRow;
-				int columnDistanceFromLeft = columnPlayed;
+				bestScore = bestHeuristicScoreForOpponentMoveSeries(depth, isUserCoin, gameBoard, alpha, beta, firstMove, bestMove);
+			}
 
-				slidingWindowStartRowPosition = coinDroppedInRow - std::min(rowDistanceFromTop, columnDistanceFromLeft);
-				slidingWindowStartColumnPosition = columnPlayed - std::min(rowDistanceFromTop, columnDistanceFromLeft);
+			//Scores from a search that ran out of time are not worth keeping
+			if (this->searchAborted.load(std::memory_order_relaxed)) {
+				return bestScore;
 			}
 
-			//Consider each four-in-a-row window starting from three before dropped column and ending at the dropped position
-			for (int startRow = slidingWindowStartRowPosition, startColumn = slidingWindowStartColumnPosition; startColumn <= columnPlayed; ++startRow, ++startColumn) {
+			int ply = this->searchDepth - depth;
+			SearchThreadCounters& searchThreadCounters = getSearchThreadCounters();
+			++searchThreadCounters.nodesAtPly[ply];
+			if (this->alphaBetaPruningEnabled && bestScore >= beta && bestMove >= 0) {
+				++searchThreadCounters.cutoffsAtPly[ply];
+				++searchThreadCounters.cutoffs;
+				recordCutoffMove(depth, isUserCoin, bestMove);
+			}
 
-				if (startColumn + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW > gameBoard.getNumberOfColumns() - 1 ||
-					startRow + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW > gameBoard.getNumberOfRows() - 1) {
-					break;
+			if (useTranspositionTable) {
+				entry.depth = depth;
+				entry.score = bestScore;
+				entry.bestMove = getTranspositionMove(gameBoard, bestMove, isMirrored);
+				if (!this->alphaBetaPruningEnabled || (bestScore > alpha && bestScore < beta)) {
+					entry.boundType = TranspositionTable::BoundType::exact;
 				}
-				else {
-					endRow = startRow + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
-					endColumn = startColumn + COLUMN_OR_ROW_DIFFERENCE_FOR_FOUR_IN_A_ROW;
+				else if (bestScore >= beta) {
+					entry.boundType = TranspositionTable::BoundType::lowerBound;
 				}
-
-				if (isEmptyOrRequiredType(gameBoard.getBoardIndex(startRow, startColumn), gameBoard.getBoardIndex(endRow, endColumn), isUserCoin, hueristicScore, gameBoard)) {
-					if (hueristicScore == INT_MAX) {
-						return INT_MAX;
-					}
-					else {
-						totalHueristicScore += hueristicScore;
-					}
+				else {
+					entry.boundType = TranspositionTable::BoundType::upperBound;
 				}
+				this->transpositionTable.store(positionKey, entry);
 			}
 
-			return totalHueristicScore;
-		}
+			return bestScore;
 
-		//Find best move by considering all columns in parallel using the Map pattern
-		int evaluatePotentialMovesInParallel() {
+		}
 
-			int depth = this->gameDifficultyLevel;
-			std::vector<int> moveScores(this->gameBoard.getNumberOfColumns());
+		//Check if the search has been cancelled or has run past its time budget. The first iteration of a search with a time budget always finishes so that there is a move to play.
+		bool isSearchOutOfTime() const {
 
-			tbb::parallel_for(
-				tbb::blocked_range<int>(0, this->gameBoard.getNumberOfColumns()),
-				[=, &moveScores](tbb::blocked_range<int> range) {
+			if (this->searchCancelled.load(std::memory_order_relaxed)) {
+				return true;
+			}
 
-				for (int columnCounter = range.begin(); columnCounter != range.end(); ++columnCounter) {
-					if (this->gameBoard.isValidPlay(columnCounter)) {
+			return this->searchDepth > 1 && this->moveTimeBudgetInMilliseconds > 0 && std::chrono::steady_clock::now() >= this->searchDeadline;
+		}
 
-						//Make a copy of the current gameboard to simulate a dropped coin
-						model::GameBoard whatIfGameBoard{ this->gameBoard.getGameBoardVector(), this->gameBoard.getNumberOfRows(), this->gameBoard.getNumberOfColumns() };
-						whatIfGameBoard.forceDropCoin(columnCounter, false);
-						moveScores.at(columnCounter) = getMoveHueristicScore(depth, columnCounter, false, whatIfGameBoard);
+		//Compute and return the hueristic score for the move. Scores outside the alpha-beta window are returned as bounds.
+		int getMoveHueristicScore(int depth, int columnPlayed, bool isUserCoin, GameBoard& gameBoard, int alpha, int beta) {
 
-					}
-				}
+			//If maximum depth has been reached, then return
+			if (depth == 0) {
+				return 0;
 			}
-			);
 
-			int bestMove = 0, bestScore = -1 * INT_MAX;
-			for (int moveCounter = 0; moveCounter < this->gameBoard.getNumberOfColumns(); ++moveCounter) {
-				if (moveScores.at(moveCounter) > bestScore) {
-					bestScore = moveScores.at(moveCounter);
-					bestMove = moveCounter;
+			SearchThreadCounters& searchThreadCounters = getSearchThreadCounters();
+			searchThreadCounters.maximumDepthReached = std::max(searchThreadCounters.maximumDepthReached, this->searchDepth - depth + 1);
+
+			//Stop searching once the time budget has run out. The clock is only read every so often since reading it costs more
+			//than a node, and the nodes are added to the progress count at the same time.
+			if (this->searchAborted.load(std::memory_order_relaxed)) {
+				return 0;
+			}
+			else if (++searchThreadCounters.nodesSearched % NODES_BETWEEN_DEADLINE_CHECKS == 0) {
+				this->nodesSearched.fetch_add(NODES_BETWEEN_DEADLINE_CHECKS, std::memory_order_relaxed);
+				if (isSearchOutOfTime()) {
+					this->searchAborted = true;
+					return 0;
 				}
 			}
 
-			return bestMove;
-
-		}
-
-		//Find best move by considering all columns in one after the other
-		int evaluatePotentialMovesInSeries() {
+			//If it was a winning move, then return with indicator saying so
+			if (gameBoard.isWinningPlay(columnPlayed)) {
+				return INT_MAX;
+			}
 
-			int depth = this->gameDifficultyLevel, currentScore, bestScore = -1 * INT_MAX, bestMove = 0;
-			for (int columnCounter = 0; columnCounter < this->gameBoard.getNumberOfColumns(); ++columnCounter) {
+			//Compute hueristic score for horizontal, vertical and diagonal four coins in a row resulting from 
+			//coin being dropped in column. If it was a winning move, then return with indicator saying so
+			++searchThreadCounters.evaluationCalls;
+			int heuristicScoreForCurrentMove = getHueristicScore(columnPlayed, gameBoard, isUserCoin);
+			if (heuristicScoreForCurrentMove == INT_MAX) {
+				return INT_MAX;
+			}
 
-				if (this->gameBoard.isValidPlay(columnCounter)) {
-					//Make a copy of the current gameboard to simulate a dropped coin
-					model::GameBoard whatIfGameBoard(this->gameBoard.getGameBoardVector(), this->gameBoard.getNumberOfRows(), this->gameBoard.getNumberOfColumns());
-					whatIfGameBoard.forceDropCoin(columnCounter, false);
-					currentScore = getMoveHueristicScore(depth, columnCounter, false, whatIfGameBoard);
+			//The best opponent move is subtracted from the score for this move, so the opponent window is this window flipped around it
+			int opponentAlpha = clampScore(static_cast<long long>(heuristicScoreForCurrentMove) - beta);
+			int opponentBeta = clampScore(static_cast<long long>(heuristicScoreForCurrentMove) - alpha);
+			int bestOpponentMoveScore = bestHeuristicScoreForOpponentMove(depth - 1, isUserCoin ? false : true, gameBoard, opponentAlpha, opponentBeta);
 
-					if (currentScore > bestScore) {
-						bestScore = currentScore;
-						bestMove = columnCounter;
-					}
-				}
+			if (bestOpponentMoveScore == INT_MAX || bestOpponentMoveScore == -INT_MAX) {
+				return -1 * bestOpponentMoveScore;
 			}
-			return bestMove;
+			else {
+				return clampScore(static_cast<long long>(heuristicScoreForCurrentMove) - bestOpponentMoveScore);
+			}
+			 
 		}
 
-		//Consider all possible moves and play the one with the best hueristic score that maximizes the chance of winning 
-		int counterUserMove() {
-			if (this->gameModeIsParallel) {
-				return evaluatePotentialMovesInParallel();
+		//Score for a four-in-a-row window holding this many coins of the player and none of the opponent
+		static int getHueristicScoreForCoinsInRow(int coinCount) {
+
+			if (coinCount == 1) {
+				return HEURISTIC_SCORE_FOR_ONE_IN_ROW;
+			}
+			else if (coinCount == 2) {
+				return HEURISTIC_SCORE_FOR_TWO_IN_ROW;
+			}
+			else if (coinCount == 3) {
+				return HEURISTIC_SCORE_FOR_THREE_IN_ROW;
+			}
+			else if (coinCount == 4) {
+				return HEURISTIC_SCORE_FOR_FOUR_IN_ROW;
 			}
 			else {
-				return evaluatePotentialMovesInSeries();
+				return 0;
 			}
 		}
 
-		//Drop a coin into one of the columns
-		void dropCoin(int dropInColumn, bool isUserCoin) {
+		//Heuristic score for dropping a coin in the column played for all potential four-in-a-row configurations through it.
+		//The game board keeps the number of coins of each player in every window, so this only reads at most sixteen counts.
+		//It is far too little work to be worth splitting across tasks, so it always runs on the calling thread.
+		int getHueristicScore(int columnPlayed, const GameBoard& gameBoard, bool isUserCoin) {
 
-			//First check if the play is a valid one
-			if (this->gameBoard.isValidPlay(dropInColumn)) {
+			int numberOfWindows, totalHueristicScore = 0;
+			const int* windowIndices = gameBoard.getWindowsContainingSlot(gameBoard.getPlayedSlot(columnPlayed), numberOfWindows);
 
-				//Place a user coin in the top available position
-				GameSlot& gameSlot = this->gameBoard.getGameSlot(this->gameBoard.getAvailableSlot(dropInColumn));
-				gameSlot.putCoin(isUserCoin);
+			for (int windowCounter = 0; windowCounter < numberOfWindows; ++windowCounter) {
 
-				if (wasWinningPlay(dropInColumn, true) || isGameBoardFull()) {
-					endTheGame(true);
-				}
-				else {
-					//Make a move to best counter the user move
-					int columnToPlay = counterUserMove();
-					//std::cout << "User move countered by dropping in column " << columnToPlay << std::endl;
-					int rowToPlay = this->gameBoard.getRowNumber(this->gameBoard.getAvailableSlot(columnToPlay));
-					GameSlot& gameSlot = this->gameBoard.getGameSlot(this->gameBoard.getBoardIndex(rowToPlay, columnToPlay));
-					gameSlot.putCoin(false);
-					if (wasWinningPlay(columnToPlay, false) || isGameBoardFull()) {
-						endTheGame(false);
+				int windowIndex = windowIndices[windowCounter];
+				int ownCoins = isUserCoin ? gameBoard.getUserCoinsInWindow(windowIndex) : gameBoard.getComputerCoinsInWindow(windowIndex);
+				int opponentCoins = isUserCoin ? gameBoard.getComputerCoinsInWindow(windowIndex) : gameBoard.getUserCoinsInWindow(windowIndex);
+
+				//Windows already blocked by the opponent can never become four in a row
+				if (opponentCoins == 0) {
+					int hueristicScore = getHueristicScoreForCoinsInRow(ownCoins);
+					if (hueristicScore == INT_MAX) {
+						return INT_MAX;
 					}
+					totalHueristicScore += hueristicScore;
 				}
 			}
+
+			return totalHueristicScore;
 		}
 
+		//Pick the lowest valid column with the best score. If every move loses, play the first valid column.
+		int getBestMove(const GameBoard& rootBoard, const std::vector<int>& moveScores) const {
 
-	public:
+			int bestMove = -1, bestScore = -1 * INT_MAX;
+			for (int moveCounter = 0; moveCounter < rootBoard.getNumberOfColumns(); ++moveCounter) {
+				if (rootBoard.isValidPlay(moveCounter)) {
+					if (bestMove == -1 || moveScores.at(moveCounter) > bestScore) {
+						bestScore = moveScores.at(moveCounter);
+						bestMove = moveCounter;
+					}
+				}
+			}
 
-		//Default constructor will set game parameters using default values
-		ConnectFourGame() {
+			return bestMove;
 
-			gameBoard = model::GameBoard();
-			this->firstPlayerIsUser = DEFAULT_FIRST_PLAYER_IS_USER;
-			this->gameDifficultyLevel = DEFAULT_DIFFICULTY_LEVEL;
-			this->gameModeIsParallel = DEFAULT_MODE_IS_PARALLEL;
-			this->gameIsOver = false;
+		}
 
+		//Give the moves left out on a symmetric root board the scores of their mirror images. Ties go to the lowest column,
+		//so the move played is the one that was searched.
+		static void copyMirroredMoveScores(const GameBoard& rootBoard, std::vector<int>& moveScores) {
+
+			for (int columnCounter = rootBoard.getNumberOfColumns() - 1; columnCounter > rootBoard.getMirroredColumn(columnCounter); --columnCounter) {
+				moveScores.at(columnCounter) = moveScores.at(rootBoard.getMirroredColumn(columnCounter));
+			}
 		}
 
-		ConnectFourGame(int numberOfRows, int numberOfColumns) {
+		//Move to search first on the root board. With search reuse it is the best move stored for the position by the last
+		//iteration, or by the search for the last turn, which looked at the position two plies below its root.
+		int getRootFirstMove(const GameBoard& rootBoard) const {
 
-			gameBoard = model::GameBoard(numberOfRows, numberOfColumns);
+			TranspositionTable::Entry entry;
+			bool isMirrored;
+			if (this->searchReuseEnabled && this->transpositionTableEnabled && this->transpositionTable.lookup(getTranspositionKey(rootBoard, false, isMirrored), entry)) {
+				return getTranspositionMove(rootBoard, entry.bestMove, isMirrored);
+			}
+
+			return -1;
+		}
+
+		//Store the result of the search on the root board so that the next iteration or the next turn starts from its best move.
+		//The score is exact once the search has found it inside its window.
+		void storeRootResult(const GameBoard& rootBoard, int rootScore, int bestMove) {
+
+			if (!this->searchReuseEnabled || !this->transpositionTableEnabled || bestMove < 0 || this->searchAborted) {
+				return;
+			}
+
+			bool isMirrored;
+			std::uint64_t positionKey = getTranspositionKey(rootBoard, false, isMirrored);
+			TranspositionTable::Entry entry = { this->searchDepth, TranspositionTable::BoundType::exact, rootScore, getTranspositionMove(rootBoard, bestMove, isMirrored) };
+			this->transpositionTable.store(positionKey, entry);
+		}
+
+		//Find best move by searching the first column and then the rest of the columns in parallel. The score of the root board
+		//is a bound if it falls outside the window, and once it is at or above the top of the window the columns left are skipped.
+		int evaluatePotentialMovesInParallel(const GameBoard& rootBoard, int windowAlpha, int windowBeta, int& rootScore) {
+
+			int depth = this->searchDepth;
+			std::vector<int> moveScores(rootBoard.getNumberOfColumns(), -1 * INT_MAX);
+			std::atomic<int> bestScore(-1 * INT_MAX);
+
+			//Score a column on a board of its own. Scores equal to the best one so far are kept exact so that ties go to the lowest column as in the serial search.
+			//A window just below a win does not survive being flipped for the opponent, so once a win is found the rest of the columns are searched in full.
+			auto scoreColumn = [=, &rootBoard, &moveScores, &bestScore](int columnCounter) {
+
+				int currentBestScore = bestScore.load();
+				if (windowBeta < INT_MAX && currentBestScore >= windowBeta) {
+					return;
+				}
+
+				GameBoard& whatIfGameBoard = acquireSearchBoard(rootBoard);
+				whatIfGameBoard.dropCoin(columnCounter, false);
+
+				int alpha = this->alphaBetaPruningEnabled && currentBestScore < INT_MAX ? clampScore(static_cast<long long>(currentBestScore) - 1) : -1 * INT_MAX;
+				moveScores.at(columnCounter) = getMoveHueristicScore(depth, columnCounter, false, whatIfGameBoard, std::max(alpha, windowAlpha), windowBeta);
+				raiseSharedScore(bestScore, moveScores.at(columnCounter));
+
+				releaseSearchBoard();
+			};
+
+			//The first column in the static order gives the rest of the columns a bound before any of them start
+			int orderedMoves[MAXIMUM_NUMBER_OF_MOVES];
+			int numberOfMoves = getOrderedMoves(depth, false, rootBoard, getRootFirstMove(rootBoard), orderedMoves);
+			bool rootIsSymmetric = isSymmetricPosition(rootBoard);
+			scoreColumn(orderedMoves[0]);
+
+			tbb::task_group columnsGroup;
+			getSearchThreadCounters().tasksSpawned += numberOfMoves - 1;
+			for (int moveCounter = 1; moveCounter < numberOfMoves; ++moveCounter) {
+				int columnCounter = orderedMoves[moveCounter];
+				columnsGroup.run([=, &scoreColumn] { scoreColumn(columnCounter); });
+			}
+			columnsGroup.wait();
+
+			if (rootIsSymmetric) {
+				copyMirroredMoveScores(rootBoard, moveScores);
+			}
+			rootScore = bestScore.load();
+			return getBestMove(rootBoard, moveScores);
+
+		}
+
+		//Find best move by considering all columns in one after the other. The score of the root board is a bound if it falls
+		//outside the window, and once it is at or above the top of the window the columns left are skipped.
+		int evaluatePotentialMovesInSeries(const GameBoard& rootBoard, int windowAlpha, int windowBeta, int& rootScore) {
+
+			int depth = this->searchDepth, bestScore = -1 * INT_MAX;
+			std::vector<int> moveScores(rootBoard.getNumberOfColumns(), -1 * INT_MAX);
+
+			//The whole search plays and takes back coins on one copy of the game board
+			GameBoard& whatIfGameBoard = acquireSearchBoard(rootBoard);
+
+			int orderedMoves[MAXIMUM_NUMBER_OF_MOVES], bestColumn = -1;
+			int numberOfMoves = getOrderedMoves(depth, false, rootBoard, getRootFirstMove(rootBoard), orderedMoves);
+			bool rootIsSymmetric = isSymmetricPosition(rootBoard);
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+
+				int columnCounter = orderedMoves[moveCounter];
+				whatIfGameBoard.dropCoin(columnCounter, false);
+
+				//A column to the right of the best one only replaces it if it is strictly better, so it only needs to be searched above the best score.
+				//Ties go to the lowest column, so a column to the left of it keeps scores equal to the best one exact, in full once a win is found.
+				int alpha = bestScore;
+				if (columnCounter < bestColumn) {
+					alpha = bestScore < INT_MAX ? clampScore(static_cast<long long>(bestScore) - 1) : -1 * INT_MAX;
+				}
+				moveScores.at(columnCounter) = getMoveHueristicScore(depth, columnCounter, false, whatIfGameBoard, std::max(alpha, windowAlpha), windowBeta);
+				if (moveScores.at(columnCounter) > bestScore || (moveScores.at(columnCounter) == bestScore && columnCounter < bestColumn)) {
+					bestScore = moveScores.at(columnCounter);
+					bestColumn = columnCounter;
+				}
+
+				whatIfGameBoard.removeCoin(columnCounter);
+				if (windowBeta < INT_MAX && bestScore >= windowBeta) {
+					break;
+				}
+			}
+
+			releaseSearchBoard();
+			if (rootIsSymmetric) {
+				copyMirroredMoveScores(rootBoard, moveScores);
+			}
+			rootScore = bestScore;
+			return getBestMove(rootBoard, moveScores);
+		}
+
+		//Search all possible computer moves from the root board to the current search depth with a window on its score
+		int evaluatePotentialMovesInWindow(const GameBoard& rootBoard, int windowAlpha, int windowBeta, int& rootScore) {
+
+			++this->rootSearches;
+			if (this->gameModeIsParallel && this->searchDepth >= this->parallelSearchDepthCutoff) {
+				return evaluatePotentialMovesInParallel(rootBoard, windowAlpha, windowBeta, rootScore);
+			}
+			else {
+				return evaluatePotentialMovesInSeries(rootBoard, windowAlpha, windowBeta, rootScore);
+			}
+		}
+
+		//Search with a window around the guess, widened to every score on the side the score falls outside it. The move found
+		//in the window is the one the full window finds.
+		int evaluatePotentialMovesWithAspirationWindow(const GameBoard& rootBoard, int scoreGuess, int& rootScore) {
+
+			int windowAlpha = clampScore(static_cast<long long>(scoreGuess) - ASPIRATION_WINDOW_MARGIN);
+			int windowBeta = clampScore(static_cast<long long>(scoreGuess) + ASPIRATION_WINDOW_MARGIN);
+			while (true) {
+
+				int bestMove = evaluatePotentialMovesInWindow(rootBoard, windowAlpha, windowBeta, rootScore);
+				if (this->searchAborted) {
+					return bestMove;
+				}
+				else if (rootScore <= windowAlpha && windowAlpha > -1 * INT_MAX) {
+					windowAlpha = -1 * INT_MAX;
+				}
+				else if (rootScore >= windowBeta && windowBeta < INT_MAX) {
+					windowBeta = INT_MAX;
+				}
+				else {
+					return bestMove;
+				}
+			}
+		}
+
+		//Close in on the score with null window searches, each just above the lower bound found so far or at the upper bound,
+		//starting from the guess. The move is the one that reached the score, which may be a different column from the one the
+		//full window finds if several reach it.
+		int evaluatePotentialMovesWithMtdf(const GameBoard& rootBoard, int scoreGuess, int& rootScore) {
+
+			int lowerBound = -1 * INT_MAX, upperBound = INT_MAX, bestMove = -1;
+			rootScore = scoreGuess;
+			while (lowerBound < upperBound) {
+
+				//A window just below a win does not survive being flipped for the opponent, so scores that close to a win are searched in full
+				long long beta = rootScore == lowerBound ? static_cast<long long>(rootScore) + 1 : rootScore;
+				if (beta >= INT_MAX || beta - 1 <= -1 * INT_MAX) {
+					return evaluatePotentialMovesInWindow(rootBoard, -1 * INT_MAX, INT_MAX, rootScore);
+				}
+
+				int probeMove = evaluatePotentialMovesInWindow(rootBoard, static_cast<int>(beta - 1), static_cast<int>(beta), rootScore);
+				if (this->searchAborted) {
+					return bestMove >= 0 ? bestMove : probeMove;
+				}
+				else if (rootScore < beta) {
+					upperBound = rootScore;
+					bestMove = bestMove >= 0 ? bestMove : probeMove;
+				}
+				else {
+					lowerBound = rootScore;
+					bestMove = probeMove;
+				}
+			}
+
+			return bestMove;
+		}
+
+		//Guess at the score of the root board from the transposition table, left by the last depth of this search or by the
+		//search for the last turn, which looked at the position two plies below its root. Returns false if there is no guess.
+		bool getRootScoreGuess(const GameBoard& rootBoard, int& scoreGuess) const {
+
+			TranspositionTable::Entry entry;
+			bool isMirrored;
+			if (this->transpositionTableEnabled && this->transpositionTable.lookup(getTranspositionKey(rootBoard, false, isMirrored), entry) &&
+				entry.depth > 0 && entry.score < INT_MAX && entry.score > -1 * INT_MAX) {
+				scoreGuess = entry.score;
+				return true;
+			}
+
+			return false;
+		}
+
+		//Search all possible computer moves from the root board to the current search depth and return the best one. Narrower
+		//windows start from a guess at the score, and searches without a guess or without alpha-beta pruning use the full window.
+		int evaluatePotentialMoves(const GameBoard& rootBoard, bool hasScoreGuess, int scoreGuess, int& rootScore) {
+
+			int bestMove;
+			if (!this->alphaBetaPruningEnabled || !hasScoreGuess || this->searchWindow == SearchWindow::full) {
+				bestMove = evaluatePotentialMovesInWindow(rootBoard, -1 * INT_MAX, INT_MAX, rootScore);
+			}
+			else if (this->searchWindow == SearchWindow::aspiration) {
+				bestMove = evaluatePotentialMovesWithAspirationWindow(rootBoard, scoreGuess, rootScore);
+			}
+			else {
+				bestMove = evaluatePotentialMovesWithMtdf(rootBoard, scoreGuess, rootScore);
+			}
+
+			storeRootResult(rootBoard, rootScore, bestMove);
+			return bestMove;
+		}
+
+		//Search one ply deeper at a time until the time budget runs out and return the best move from the last search that finished.
+		//Each search puts its best moves in the transposition table and the move ordering tables, which makes the next one faster.
+		int searchBestMoveWithinTimeBudget(const GameBoard& rootBoard, int& depthCompleted) {
+
+			this->searchDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->moveTimeBudgetInMilliseconds);
+			int maximumDepth = std::max(1, rootBoard.getNumberOfEmptySlots());
+			prepareSearchBoards(rootBoard, maximumDepth);
+			prepareMoveOrdering(maximumDepth);
+
+			//Each depth takes the score of the one before as its guess
+			int bestMove = -1, rootScore = 0;
+			bool hasScoreGuess = getRootScoreGuess(rootBoard, rootScore);
+			for (this->searchDepth = 1; this->searchDepth <= maximumDepth; ++this->searchDepth) {
+
+				int columnToPlay = evaluatePotentialMoves(rootBoard, hasScoreGuess, rootScore, rootScore);
+				if (this->searchAborted) {
+					break;
+				}
+				hasScoreGuess = rootScore < INT_MAX && rootScore > -1 * INT_MAX;
+
+				bestMove = columnToPlay;
+				depthCompleted = this->searchDepth;
+				this->depthCompletedInSearch = depthCompleted;
+				if (std::chrono::steady_clock::now() >= this->searchDeadline) {
+					break;
+				}
+			}
+
+			return bestMove;
+		}
+
+		//Check if the endgame solver takes over from the heuristic search for the position on the root board
+		bool isSolvableEndgame(const GameBoard& rootBoard) const {
+			return rootBoard.getNumberOfEmptySlots() < this->endgameSolverThreshold && EndgameSolver::canSolve(rootBoard.getNumberOfRows(), rootBoard.getNumberOfColumns());
+		}
+
+		//Find the computer move that wins soonest, draws or loses latest by searching every line to the end of the game
+		int solveEndgame(const GameBoard& rootBoard, int& depthCompleted) {
+
+			if (!this->endgameSolver) {
+				this->endgameSolver.reset(new EndgameSolver(rootBoard.getNumberOfRows(), rootBoard.getNumberOfColumns()));
+			}
+
+			depthCompleted = rootBoard.getNumberOfEmptySlots();
+			prepareMoveOrdering(depthCompleted);
+			EndgameSolver::Solution solution = this->endgameSolver->solve(rootBoard, false);
+			this->nodesSearched = this->endgameSolver->getNodesSearched();
+			getSearchThreadCounters().nodesSearched = this->endgameSolver->getNodesSearched();
+			getSearchThreadCounters().maximumDepthReached = depthCompleted;
+			this->boardAllocations = 0;
+			this->depthCompletedInSearch = depthCompleted;
+			return solution.bestMove;
+		}
+
+		//Play out games from the root board with Monte Carlo tree search until the time budget runs out, or for a number of
+		//games that grows with the difficulty level, and return the move played out most often. The depth completed is the
+		//deepest the tree grew, and each game played out counts as a node searched.
+		int searchBestMoveByPlayouts(const GameBoard& rootBoard, int& depthCompleted) {
+
+			if (!this->monteCarloTreeSearch) {
+				this->monteCarloTreeSearch.reset(new MonteCarloTreeSearch(rootBoard.getNumberOfRows(), rootBoard.getNumberOfColumns()));
+			}
+
+			prepareMoveOrdering(0);
+			long long maximumPlayouts = static_cast<long long>(this->gameDifficultyLevel) * PLAYOUTS_PER_DIFFICULTY_LEVEL;
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+			if (this->moveTimeBudgetInMilliseconds > 0) {
+				maximumPlayouts = 0;
+				deadline = this->searchStartTime + std::chrono::milliseconds(this->moveTimeBudgetInMilliseconds);
+			}
+
+			MonteCarloTreeSearch::Result result = this->monteCarloTreeSearch->search(rootBoard, false, maximumPlayouts, deadline,
+				this->gameModeIsParallel, this->searchCancelled, this->nodesSearched);
+			for (size_t threadCounter = 0; threadCounter < result.playoutsPerThread.size() && threadCounter < this->searchThreadCounters.size(); ++threadCounter) {
+				this->searchThreadCounters[threadCounter].nodesSearched = result.playoutsPerThread[threadCounter];
+			}
+			getSearchThreadCounters().maximumDepthReached = result.maximumDepthReached;
+			this->boardAllocations = 0;
+
+			if (this->searchCancelled) {
+				this->searchAborted = true;
+				return -1;
+			}
+
+			depthCompleted = result.maximumDepthReached;
+			this->depthCompletedInSearch = depthCompleted;
+			return result.bestMove;
+		}
+
+		//Sum of the nodes searched on every thread so far. Only meaningful while no tasks of the search are running.
+		long long getNodesSearchedOnEveryThread() const {
+
+			long long nodesSearched = 0;
+			for (const SearchThreadCounters& searchThreadCounters : this->searchThreadCounters) {
+				nodesSearched += searchThreadCounters.nodesSearched;
+			}
+			return nodesSearched;
+		}
+
+		//Follow the best moves kept in the transposition table from the position after a computer move for up to the given
+		//number of plies. The line stops early where an entry has been replaced or a move ends the game. The moves are taken
+		//back from the board before returning.
+		std::vector<int> getPrincipalVariation(GameBoard& whatIfGameBoard, int column, int numberOfPlies) const {
+
+			std::vector<int> principalVariation(1, column);
+			whatIfGameBoard.dropCoin(column, false);
+
+			bool isUserCoin = true, gameIsOver = whatIfGameBoard.isWinningPlay(column);
+			TranspositionTable::Entry entry;
+			bool isMirrored;
+			while (!gameIsOver && static_cast<int>(principalVariation.size()) < numberOfPlies) {
+
+				//Wins with the next coin are found before the position is stored, so they are checked for first
+				int move = -1;
+				if (hasWinningDrop(1, isUserCoin, whatIfGameBoard)) {
+					for (move = 0; !whatIfGameBoard.isWinningDrop(move, isUserCoin); ++move) {
+					}
+				}
+				else if (this->transpositionTable.lookup(getTranspositionKey(whatIfGameBoard, isUserCoin, isMirrored), entry)) {
+					move = getTranspositionMove(whatIfGameBoard, entry.bestMove, isMirrored);
+				}
+				if (move < 0 || !whatIfGameBoard.isValidPlay(move)) {
+					break;
+				}
+
+				whatIfGameBoard.dropCoin(move, isUserCoin);
+				principalVariation.push_back(move);
+				gameIsOver = whatIfGameBoard.isWinningPlay(move);
+				isUserCoin = !isUserCoin;
+			}
+
+			for (auto move = principalVariation.rbegin(); move != principalVariation.rend(); ++move) {
+				whatIfGameBoard.removeCoin(*move);
+			}
+			return principalVariation;
+		}
+
+		//Keep the line the search expects after the computer's move, along with the transposition table key and move of every
+		//position on it, so that the next search can put back the entries other searches replace in the meantime
+		void recordPrincipalVariation(const GameBoard& rootBoard, int column, int numberOfPlies) {
+
+			this->principalVariationForLastMove.clear();
+			this->principalVariationEntries.clear();
+			if (column < 0) {
+				return;
+			}
+
+			GameBoard whatIfGameBoard = rootBoard;
+			this->principalVariationForLastMove = getPrincipalVariation(whatIfGameBoard, column, std::max(1, numberOfPlies));
+
+			bool isUserCoin = false, isMirrored;
+			for (int move : this->principalVariationForLastMove) {
+				std::uint64_t positionKey = getTranspositionKey(whatIfGameBoard, isUserCoin, isMirrored);
+				this->principalVariationEntries.push_back(std::make_pair(positionKey, getTranspositionMove(whatIfGameBoard, move, isMirrored)));
+				whatIfGameBoard.dropCoin(move, isUserCoin);
+				isUserCoin = !isUserCoin;
+			}
+		}
+
+		//Put the moves of the line expected by the search for the last computer move back into the transposition table where
+		//their entries have been replaced. Only the move is kept, at depth zero so that no search takes its score as a bound.
+		void reseedPrincipalVariation() {
+
+			if (!this->searchReuseEnabled || !this->transpositionTableEnabled) {
+				return;
+			}
+
+			TranspositionTable::Entry entry;
+			for (const std::pair<std::uint64_t, int>& principalVariationEntry : this->principalVariationEntries) {
+				if (!this->transpositionTable.lookup(principalVariationEntry.first, entry)) {
+					TranspositionTable::Entry moveOnlyEntry = { 0, TranspositionTable::BoundType::upperBound, INT_MAX, principalVariationEntry.second };
+					this->transpositionTable.store(principalVariationEntry.first, moveOnlyEntry);
+				}
+			}
+		}
+
+		//Score every column on the root board with a full window to the current search depth, one column after the other so that
+		//the nodes searched for each can be told apart, with the work for each column spread across threads. A column left out
+		//on a symmetric board takes the results of its mirror image. Returns false, and leaves the analyses of the last depth,
+		//if the search ran out of time.
+		bool analyzeColumns(const GameBoard& rootBoard, std::vector<ColumnAnalysis>& columnAnalyses) {
+
+			int depth = this->searchDepth, numberOfColumns = rootBoard.getNumberOfColumns();
+			std::vector<int> moveScores(numberOfColumns, INT_MIN);
+			std::vector<long long> nodesSearched(numberOfColumns, 0);
+			bool rootIsSymmetric = isSymmetricPosition(rootBoard);
+			GameBoard& whatIfGameBoard = acquireSearchBoard(rootBoard);
+
+			for (int columnCounter : this->staticMoveOrder) {
+
+				if (!rootBoard.isValidPlay(columnCounter) || (rootIsSymmetric && rootBoard.getMirroredColumn(columnCounter) < columnCounter)) {
+					continue;
+				}
+
+				long long nodesBefore = getNodesSearchedOnEveryThread();
+				whatIfGameBoard.dropCoin(columnCounter, false);
+				moveScores[columnCounter] = getMoveHueristicScore(depth, columnCounter, false, whatIfGameBoard, -1 * INT_MAX, INT_MAX);
+				whatIfGameBoard.removeCoin(columnCounter);
+				nodesSearched[columnCounter] = getNodesSearchedOnEveryThread() - nodesBefore;
+			}
+
+			for (int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter) {
+				columnAnalyses[columnCounter].nodesSearched += nodesSearched[columnCounter];
+			}
+			if (this->searchAborted) {
+				releaseSearchBoard();
+				return false;
+			}
+
+			for (int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter) {
+
+				ColumnAnalysis& columnAnalysis = columnAnalyses[columnCounter];
+				int mirroredColumn = rootBoard.getMirroredColumn(columnCounter);
+				if (!columnAnalysis.isValid) {
+					continue;
+				}
+				else if (rootIsSymmetric && mirroredColumn < columnCounter) {
+					columnAnalysis.score = moveScores[mirroredColumn];
+					columnAnalysis.principalVariation = getPrincipalVariation(whatIfGameBoard, mirroredColumn, this->searchDepth);
+					for (int& move : columnAnalysis.principalVariation) {
+						move = rootBoard.getMirroredColumn(move);
+					}
+				}
+				else {
+					columnAnalysis.score = moveScores[columnCounter];
+					columnAnalysis.principalVariation = getPrincipalVariation(whatIfGameBoard, columnCounter, this->searchDepth);
+				}
+			}
+
+			releaseSearchBoard();
+			return true;
+		}
+
+		//Find a computer move that needs no search: the lowest column that wins straight away, or the only move that does not
+		//let the user win with their next coin. Moves are only forced if the search would have looked far enough to find them.
+		bool findForcedMove(const GameBoard& rootBoard, int& forcedMove, int& depthCompleted) const {
+
+			int maximumDepth = this->moveTimeBudgetInMilliseconds > 0 ? rootBoard.getNumberOfEmptySlots() : this->gameDifficultyLevel;
+			if (hasWinningDrop(maximumDepth, false, rootBoard)) {
+				for (forcedMove = 0; !rootBoard.isWinningDrop(forcedMove, false); ++forcedMove) {
+				}
+				depthCompleted = 1;
+				return true;
+			}
+
+			if (!detectsThreats(maximumDepth)) {
+				return false;
+			}
+
+			int validMoves[MAXIMUM_NUMBER_OF_MOVES], numberOfMoves = 0;
+			for (int column = 0; column < rootBoard.getNumberOfColumns(); ++column) {
+				if (rootBoard.isValidPlay(column)) {
+					validMoves[numberOfMoves++] = column;
+				}
+			}
+
+			if (removeLosingMoves(false, rootBoard, validMoves, numberOfMoves) != 1) {
+				return false;
+			}
+
+			forcedMove = validMoves[0];
+			depthCompleted = 2;
+			return true;
+		}
+
+		//Find the best computer move from the root board, to the difficulty level or as deep as the time budget allows.
+		//Moves in the opening book are played as they are and positions close enough to the end of the game are solved
+		//exactly instead. Returns -1 if the search was cancelled before it found a move.
+		int searchBestMove(const GameBoard& rootBoard, int& depthCompleted) {
+
+			prepareSearchCounters(std::max(this->gameDifficultyLevel, rootBoard.getNumberOfEmptySlots()));
+			this->depthCompletedInSearch = 0;
+			this->searchAborted = false;
+			reseedPrincipalVariation();
+
+			//Positions in the opening book and positions with a forced move need no search at all
+			int bookMove, forcedMove;
+			if (this->openingBook.lookup(rootBoard.getPositionHash(), bookMove) && rootBoard.isValidPlay(bookMove)) {
+				prepareMoveOrdering(0);
+				depthCompleted = this->openingBook.getSearchDepth();
+				this->depthCompletedInSearch = depthCompleted;
+				return bookMove;
+			}
+			else if (isSolvableEndgame(rootBoard)) {
+				return solveEndgame(rootBoard, depthCompleted);
+			}
+			else if (findForcedMove(rootBoard, forcedMove, depthCompleted)) {
+				prepareMoveOrdering(0);
+				this->depthCompletedInSearch = depthCompleted;
+				return forcedMove;
+			}
+			else if (this->searchEngine == SearchEngine::monteCarloTreeSearch) {
+				return searchBestMoveByPlayouts(rootBoard, depthCompleted);
+			}
+			else if (this->moveTimeBudgetInMilliseconds > 0) {
+				return searchBestMoveWithinTimeBudget(rootBoard, depthCompleted);
+			}
+
+			this->searchDepth = this->gameDifficultyLevel;
+			prepareSearchBoards(rootBoard, this->searchDepth);
+			prepareMoveOrdering(this->searchDepth);
+			int scoreGuess = 0, rootScore;
+			bool hasScoreGuess = getRootScoreGuess(rootBoard, scoreGuess);
+			int columnToPlay = evaluatePotentialMoves(rootBoard, hasScoreGuess, scoreGuess, rootScore);
+			if (this->searchAborted) {
+				return -1;
+			}
+
+			depthCompleted = this->searchDepth;
+			this->depthCompletedInSearch = depthCompleted;
+			return columnToPlay;
+		}
+
+		//Merge the counters of every thread into the statistics of the search for the last computer move, so that pondering does not overwrite them
+		void recordSearchStatistics(bool moveWasPondered) {
+
+			this->lastMoveWasPondered = moveWasPondered;
+			this->searchStatsForLastMove = SearchStats();
+			this->boardAllocationsForLastMove = moveWasPondered ? 0 : this->boardAllocations.load();
+			this->cutoffRatesForLastMove.clear();
+			if (moveWasPondered) {
+				return;
+			}
+
+			SearchStats& searchStats = this->searchStatsForLastMove;
+			searchStats.rootSearches = this->rootSearches;
+			std::vector<long long> nodesAtPly, cutoffsAtPly;
+			for (const SearchThreadCounters& searchThreadCounters : this->searchThreadCounters) {
+
+				searchStats.nodesSearched += searchThreadCounters.nodesSearched;
+				searchStats.evaluationCalls += searchThreadCounters.evaluationCalls;
+				searchStats.cutoffs += searchThreadCounters.cutoffs;
+				searchStats.tasksSpawned += searchThreadCounters.tasksSpawned;
+				searchStats.maximumDepthReached = std::max(searchStats.maximumDepthReached, searchThreadCounters.maximumDepthReached);
+				searchStats.nodesSearchedPerThread.push_back(searchThreadCounters.nodesSearched);
+
+				nodesAtPly.resize(std::max(nodesAtPly.size(), searchThreadCounters.nodesAtPly.size()), 0);
+				cutoffsAtPly.resize(nodesAtPly.size(), 0);
+				for (size_t plyCounter = 0; plyCounter < searchThreadCounters.nodesAtPly.size(); ++plyCounter) {
+					nodesAtPly[plyCounter] += searchThreadCounters.nodesAtPly[plyCounter];
+					cutoffsAtPly[plyCounter] += searchThreadCounters.cutoffsAtPly[plyCounter];
+				}
+			}
+			searchStats.wallTimeInMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->searchStartTime).count();
+
+			for (size_t plyCounter = 0; plyCounter < nodesAtPly.size(); ++plyCounter) {
+				this->cutoffRatesForLastMove.push_back(nodesAtPly[plyCounter] == 0 ? 0 : static_cast<double>(cutoffsAtPly[plyCounter]) / nodesAtPly[plyCounter]);
+			}
+		}
+
+		//Consider all possible moves and play the one with the best hueristic score that maximizes the chance of winning.
+		//A reply already worked out while pondering on the user's time is played straight away.
+		int counterUserMove() {
+
+			std::uint64_t positionKey = getPositionKey(this->gameBoard, false);
+			for (const PonderedReply& ponderedReply : this->ponderedReplies) {
+				if (ponderedReply.positionKey == positionKey && ponderedReply.gameDifficultyLevel == this->gameDifficultyLevel &&
+					ponderedReply.moveTimeBudgetInMilliseconds == this->moveTimeBudgetInMilliseconds) {
+					this->depthReached = ponderedReply.depthReached;
+					recordSearchStatistics(true);
+					recordPrincipalVariation(this->gameBoard, ponderedReply.column, this->depthReached);
+					return ponderedReply.column;
+				}
+			}
+
+			int columnToPlay = searchBestMove(this->gameBoard, this->depthReached);
+			recordSearchStatistics(false);
+			recordPrincipalVariation(this->gameBoard, columnToPlay, this->depthReached);
+			return columnToPlay;
+		}
+
+		//Work out the computer's reply to every move the user can make next, starting with the move the last search
+		//expects the user to play. Runs on the search arena until every reply is found or pondering is stopped.
+		void ponder() {
+
+			std::vector<int> userMoves;
+			TranspositionTable::Entry entry;
+			bool isMirrored;
+			if (this->transpositionTable.lookup(getTranspositionKey(this->ponderingBoard, true, isMirrored), entry) &&
+				this->ponderingBoard.isValidPlay(getTranspositionMove(this->ponderingBoard, entry.bestMove, isMirrored))) {
+				userMoves.push_back(getTranspositionMove(this->ponderingBoard, entry.bestMove, isMirrored));
+			}
+			for (int column : this->staticMoveOrder) {
+				if (this->ponderingBoard.isValidPlay(column) && std::find(userMoves.begin(), userMoves.end(), column) == userMoves.end()) {
+					userMoves.push_back(column);
+				}
+			}
+
+			for (int userMove : userMoves) {
+
+				if (this->searchCancelled) {
+					break;
+				}
+
+				//Moves that end the game need no reply
+				this->ponderingBoard.dropCoin(userMove, true);
+				if (!this->ponderingBoard.isWinningPlay(userMove) && this->ponderingBoard.getNumberOfEmptySlots() > 0) {
+
+					int depthCompleted = 0;
+					int columnToPlay = searchBestMove(this->ponderingBoard, depthCompleted);
+					if (columnToPlay >= 0 && !this->searchCancelled) {
+						PonderedReply ponderedReply = { getPositionKey(this->ponderingBoard, false), columnToPlay, depthCompleted,
+							this->gameDifficultyLevel, this->moveTimeBudgetInMilliseconds };
+						this->ponderedReplies.push_back(ponderedReply);
+					}
+				}
+				this->ponderingBoard.removeCoin(userMove);
+			}
+
+			this->ponderingInProgress = false;
+		}
+
+		//Get ready to ponder on the position after the computer's move
+		void preparePondering() {
+
+			this->ponderedReplies.clear();
+			this->ponderingBoard = this->gameBoard;
+			this->ponderingInProgress = true;
+		}
+
+		//Start pondering while the user thinks
+		void startPondering() {
+
+			preparePondering();
+			this->searchCancelled = false;
+			this->backgroundSearchStarted = true;
+			this->searchArena->enqueue(this->backgroundSearchGroup.defer([this] { ponder(); }));
+		}
+
+		//Cancel the computer move or pondering running on the search arena and wait for it to stop
+		void stopBackgroundSearch() {
+
+			if (this->backgroundSearchStarted) {
+				this->searchCancelled = true;
+				this->searchArena->execute([this] { this->backgroundSearchGroup.wait(); });
+				this->searchCancelled = false;
+				this->backgroundSearchStarted = false;
+			}
+		}
+
+		//Drop the computer's coin and end the game if it won or filled the board
+		void playComputerMove(int columnToPlay) {
+
+			this->gameBoard.dropCoin(columnToPlay, false);
+			this->computerToMove = false;
+			if (wasWinningPlay(columnToPlay) || isGameBoardFull()) {
+				endTheGame(false);
+			}
+		}
+
+		//Search for the computer's move on the search arena, play it and then ponder if pondering is on
+		void searchComputerMoveInBackground(std::shared_ptr<std::promise<int> > computerMove, std::function<void(int)> onComputerMove) {
+
+			int columnToPlay = counterUserMove();
+			if (columnToPlay >= 0 && !this->searchCancelled) {
+				playComputerMove(columnToPlay);
+			}
+			else {
+				columnToPlay = -1;
+			}
+
+			this->computerMoveInProgress = false;
+			computerMove->set_value(columnToPlay);
+			if (onComputerMove) {
+				onComputerMove(columnToPlay);
+			}
+
+			if (columnToPlay >= 0 && !this->gameIsOver && this->ponderingEnabled && !this->searchCancelled) {
+				preparePondering();
+				ponder();
+			}
+		}
+
+	public:
+
+		//Default constructor will set game parameters using default values
+		BasicConnectFourGame() : defaultSearchArena(tbb::task_arena::automatic, 0) {
+
+			gameBoard = GameBoard();
 			this->firstPlayerIsUser = DEFAULT_FIRST_PLAYER_IS_USER;
 			this->gameDifficultyLevel = DEFAULT_DIFFICULTY_LEVEL;
 			this->gameModeIsParallel = DEFAULT_MODE_IS_PARALLEL;
+			this->alphaBetaPruningEnabled = DEFAULT_ALPHA_BETA_PRUNING_ENABLED;
+			this->transpositionTableEnabled = DEFAULT_TRANSPOSITION_TABLE_ENABLED;
+			this->parallelSearchDepthCutoff = DEFAULT_PARALLEL_SEARCH_DEPTH_CUTOFF;
+			this->centerFirstMoveOrderingEnabled = DEFAULT_CENTER_FIRST_MOVE_ORDERING_ENABLED;
+			this->killerMovesEnabled = DEFAULT_KILLER_MOVES_ENABLED;
+			this->historyHeuristicEnabled = DEFAULT_HISTORY_HEURISTIC_ENABLED;
+			this->symmetryReductionEnabled = DEFAULT_SYMMETRY_REDUCTION_ENABLED;
+			this->threatDetectionEnabled = DEFAULT_THREAT_DETECTION_ENABLED;
+			this->searchReuseEnabled = DEFAULT_SEARCH_REUSE_ENABLED;
+			this->moveTimeBudgetInMilliseconds = DEFAULT_MOVE_TIME_BUDGET_IN_MILLISECONDS;
+			this->searchDepth = 0;
+			this->depthReached = 0;
+			this->searchAborted = false;
+			this->searchCancelled = false;
 			this->gameIsOver = false;
+			this->nodesSearched = 0;
+			this->boardAllocations = 0;
+			this->boardAllocationsForLastMove = 0;
+			this->ponderingEnabled = DEFAULT_PONDERING_ENABLED;
+			this->backgroundSearchStarted = false;
+			this->computerToMove = false;
+			this->lastMoveWasPondered = false;
+			this->ponderingInProgress = false;
+			this->computerMoveInProgress = false;
+			this->depthCompletedInSearch = 0;
+			this->searchArena = &this->defaultSearchArena;
+			this->endgameSolverThreshold = DEFAULT_ENDGAME_SOLVER_THRESHOLD;
+			this->searchEngine = DEFAULT_SEARCH_ENGINE;
+			this->searchWindow = DEFAULT_SEARCH_WINDOW;
+			this->rootSearches = 0;
 
 		}
 
+		BasicConnectFourGame(int numberOfRows, int numberOfColumns) : defaultSearchArena(tbb::task_arena::automatic, 0) {
+
+			gameBoard = GameBoard(numberOfRows, numberOfColumns);
+			this->firstPlayerIsUser = DEFAULT_FIRST_PLAYER_IS_USER;
+			this->gameDifficultyLevel = DEFAULT_DIFFICULTY_LEVEL;
+			this->gameModeIsParallel = DEFAULT_MODE_IS_PARALLEL;
+			this->alphaBetaPruningEnabled = DEFAULT_ALPHA_BETA_PRUNING_ENABLED;
+			this->transpositionTableEnabled = DEFAULT_TRANSPOSITION_TABLE_ENABLED;
+			this->parallelSearchDepthCutoff = DEFAULT_PARALLEL_SEARCH_DEPTH_CUTOFF;
+			this->centerFirstMoveOrderingEnabled = DEFAULT_CENTER_FIRST_MOVE_ORDERING_ENABLED;
+			this->killerMovesEnabled = DEFAULT_KILLER_MOVES_ENABLED;
+			this->historyHeuristicEnabled = DEFAULT_HISTORY_HEURISTIC_ENABLED;
+			this->symmetryReductionEnabled = DEFAULT_SYMMETRY_REDUCTION_ENABLED;
+			this->threatDetectionEnabled = DEFAULT_THREAT_DETECTION_ENABLED;
+			this->searchReuseEnabled = DEFAULT_SEARCH_REUSE_ENABLED;
+			this->moveTimeBudgetInMilliseconds = DEFAULT_MOVE_TIME_BUDGET_IN_MILLISECONDS;
+			this->searchDepth = 0;
+			this->depthReached = 0;
+			this->searchAborted = false;
+			this->searchCancelled = false;
+			this->gameIsOver = false;
+			this->nodesSearched = 0;
+			this->boardAllocations = 0;
+			this->boardAllocationsForLastMove = 0;
+			this->ponderingEnabled = DEFAULT_PONDERING_ENABLED;
+			this->backgroundSearchStarted = false;
+			this->computerToMove = false;
+			this->lastMoveWasPondered = false;
+			this->ponderingInProgress = false;
+			this->computerMoveInProgress = false;
+			this->depthCompletedInSearch = 0;
+			this->searchArena = &this->defaultSearchArena;
+			this->endgameSolverThreshold = DEFAULT_ENDGAME_SOLVER_THRESHOLD;
+			this->searchEngine = DEFAULT_SEARCH_ENGINE;
+			this->searchWindow = DEFAULT_SEARCH_WINDOW;
+			this->rootSearches = 0;
+
+		}
+
+		//Background searches have to stop before the game goes away since they use the game's own tables
+		~BasicConnectFourGame() {
+			stopBackgroundSearch();
+		}
+
 		//First player will be determined by user selection
 		void setWhoPlaysFirst(bool firstPlayerIsUser) {
 			this->firstPlayerIsUser = firstPlayerIsUser;
@@ -588,32 +1612,337 @@ namespace controller {
 			this->gameModeIsParallel = parallelMode;
 		}
 
-		const model::GameBoard& getGameBoard() const {
-			return this->gameBoard;
+		//Alpha-beta pruning can be turned off to run the full minimax search
+		void setAlphaBetaPruning(bool alphaBetaPruningEnabled) {
+			this->alphaBetaPruningEnabled = alphaBetaPruningEnabled;
 		}
 
-		//User method to drop a coin into one of the columns
-		void dropCoin(int dropInColumn) {
+		//The transposition table can be turned off to search every position again each time it is reached
+		void setTranspositionTable(bool transpositionTableEnabled) {
+			this->transpositionTableEnabled = transpositionTableEnabled;
+		}
+
+		//In parallel mode, subtrees with fewer plies left than the cutoff are searched serially
+		void setParallelSearchDepthCutoff(int parallelSearchDepthCutoff) {
+			this->parallelSearchDepthCutoff = parallelSearchDepthCutoff;
+		}
+
+		//Center columns can be tried first, otherwise moves are tried from left to right
+		void setCenterFirstMoveOrdering(bool centerFirstMoveOrderingEnabled) {
+			this->centerFirstMoveOrderingEnabled = centerFirstMoveOrderingEnabled;
+		}
+
+		//Moves that caused a cutoff with the same number of plies left can be tried early
+		void setKillerMoves(bool killerMovesEnabled) {
+			this->killerMovesEnabled = killerMovesEnabled;
+		}
+
+		//Moves that caused cutoffs often during the search can be tried early
+		void setHistoryHeuristic(bool historyHeuristicEnabled) {
+			this->historyHeuristicEnabled = historyHeuristicEnabled;
+		}
+
+		//A position and its mirror image can share search results, and on a board that is its own mirror image only one of
+		//each pair of mirrored moves is searched
+		void setSymmetryReduction(bool symmetryReductionEnabled) {
+			this->symmetryReductionEnabled = symmetryReductionEnabled;
+		}
+
+		//Wins with the next coin, user wins that have to be blocked and moves that let the user win on top of them can be
+		//found by checking the board before searching any move
+		void setThreatDetection(bool threatDetectionEnabled) {
+			this->threatDetectionEnabled = threatDetectionEnabled;
+		}
+
+		//The search for each computer move can start from what the search for the last one found: the best move stored for
+		//the root, the line it expected both players to make, its killer moves and its history scores, aged by half
+		void setSearchReuse(bool searchReuseEnabled) {
+			this->searchReuseEnabled = searchReuseEnabled;
+		}
+
+		//Monte Carlo tree search plays out games in place of the minimax search, as many as the time budget allows or a fixed
+		//number for each difficulty level. The opening book, the endgame solver and forced moves are used with either engine.
+		void setSearchEngine(SearchEngine searchEngine) {
+			this->searchEngine = searchEngine;
+		}
+
+		//Aspiration windows and MTD(f) search the root with narrower windows around the score of the last depth searched, or
+		//of the position in the transposition table, and search again where the score falls outside the window
+		void setSearchWindow(SearchWindow searchWindow) {
+			this->searchWindow = searchWindow;
+		}
+
+		//With a time budget the computer searches deeper until the budget runs out instead of to the difficulty level.
+		//A budget of zero goes back to searching to the difficulty level.
+		void setMoveTimeBudget(int moveTimeBudgetInMilliseconds) {
+			this->moveTimeBudgetInMilliseconds = moveTimeBudgetInMilliseconds;
+		}
+
+		//Depth of the last search that finished when computing the last computer move
+		int getDepthReachedForLastMove() const {
+			return this->depthReached;
+		}
+
+		//Moves the search for the last computer move expects both players to make, starting with the computer's move. The
+		//line is as long as the search looked ahead, or shorter where the game ends or the transposition table lost an entry.
+		const std::vector<int>& getPrincipalVariationForLastMove() const {
+			return this->principalVariationForLastMove;
+		}
+
+		//With pondering on, the computer works out its replies to the user's possible moves while the user thinks and plays a
+		//reply it has already found straight away. Other settings must not be changed while the computer is pondering.
+		void setPondering(bool ponderingEnabled) {
 
-			if (!this->gameIsOver) {
-				dropCoin(dropInColumn, true);
+			this->ponderingEnabled = ponderingEnabled;
+			if (!ponderingEnabled) {
+				stopPondering();
 			}
 		}
 
-		//Method to check if the board has been filled and play cannot continue
-		bool isGameBoardFull() {
+		//Cancel pondering and wait for it to stop. Replies found so far are kept for the user's next move.
+		//A computer move that has been requested but not played yet is left to finish.
+		void stopPondering() {
+
+			if (!this->computerMoveInProgress) {
+				stopBackgroundSearch();
+			}
+		}
+
+		//Forget everything learned by earlier searches, so that the next search finds the same move as a new game would. Pondering
+		//is stopped first, and a computer move must not be in progress.
+		void clearSearchState() {
+
+			stopBackgroundSearch();
+			this->transpositionTable.clear();
+			resetSharedValues(this->killerMoves, 0, -1);
+			resetSharedValues(this->historyScores, 0, 0);
+			this->principalVariationForLastMove.clear();
+			this->principalVariationEntries.clear();
+			this->ponderedReplies.clear();
+			this->endgameSolver.reset();
+			this->monteCarloTreeSearch.reset();
+		}
+
+		//Check if the computer is still working out replies on the user's time
+		bool isPondering() const {
+			return this->ponderingInProgress.load();
+		}
+
+		//Check if the last computer move was found while pondering rather than searched after the user moved
+		bool wasLastMovePondered() const {
+			return this->lastMoveWasPondered;
+		}
+
+		//Fraction of positions searched at a ply below the root that were cut off when computing the last computer move
+		double getCutoffRateForLastMove(int ply) const {
+
+			if (ply < 0 || ply >= static_cast<int>(this->cutoffRatesForLastMove.size())) {
+				return 0;
+			}
+
+			return this->cutoffRatesForLastMove[ply];
+		}
+
+		//Number of positions evaluated when computing the last computer move. A pondered move needs no search once the user moves.
+		long long getNodesSearchedForLastMove() const {
+			return this->searchStatsForLastMove.nodesSearched;
+		}
+
+		//Statistics of the search for the last computer move. A pondered move needs no search once the user moves, so they are all zero.
+		const SearchStats& getSearchStatsForLastMove() const {
+			return this->searchStatsForLastMove;
+		}
+
+		//Number of boards allocated while computing the last computer move. Boards are reused between moves, so this stays at zero once the first search has run.
+		long long getBoardAllocationsForLastMove() const {
+			return this->boardAllocationsForLastMove;
+		}
+
+		const GameBoard& getGameBoard() const {
+			return this->gameBoard;
+		}
+
+		//Positions with fewer empty slots than the threshold are solved to the end of the game, which is exact and quicker
+		//than the heuristic search once most of the board is full. A threshold of zero always uses the heuristic search.
+		void setEndgameSolverThreshold(int endgameSolverThreshold) {
+			this->endgameSolverThreshold = endgameSolverThreshold;
+		}
 
-			//Check to see that at least one slot in the top row is empty
-			for (int counter = 0; counter < this->gameBoard.getNumberOfColumns(); ++counter) {
-				if (this->gameBoard.getGameSlot(counter).isEmpty()) {
-					return false;
+		//Map an opening book built for boards of this size. Returns false, and plays without a book, if the file cannot be used.
+		bool loadOpeningBook(const std::string& fileName) {
+
+			stopBackgroundSearch();
+			return this->openingBook.open(fileName, this->gameBoard.getNumberOfRows(), this->gameBoard.getNumberOfColumns());
+		}
+
+		//Best computer move for a position with the computer to play, found with the current settings. The game itself is left
+		//alone, but the statistics for the last computer move are those of this search.
+		int searchComputerMove(const GameBoard& position) {
+
+			stopBackgroundSearch();
+			int columnToPlay = searchBestMove(position, this->depthReached);
+			recordSearchStatistics(false);
+			recordPrincipalVariation(position, columnToPlay, this->depthReached);
+			return columnToPlay;
+		}
+
+		//Score, principal variation and nodes searched for every column for the computer on a position, all from one search to
+		//the difficulty level or as deep as the time budget allows. Each column is searched with a full window, so the scores
+		//are exact rather than the bounds a search for the best move leaves behind for the moves it rejects. The opening book
+		//and the endgame solver are not used, and the statistics for the last computer move are those of this search.
+		std::vector<ColumnAnalysis> analyze(const GameBoard& position) {
+
+			stopBackgroundSearch();
+			int maximumDepth = this->moveTimeBudgetInMilliseconds > 0 ? std::max(1, position.getNumberOfEmptySlots()) : std::max(1, this->gameDifficultyLevel);
+			prepareSearchCounters(maximumDepth);
+			prepareSearchBoards(position, maximumDepth);
+			prepareMoveOrdering(maximumDepth);
+			this->searchAborted = false;
+			this->searchDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->moveTimeBudgetInMilliseconds);
+
+			std::vector<ColumnAnalysis> columnAnalyses(position.getNumberOfColumns());
+			for (int columnCounter = 0; columnCounter < position.getNumberOfColumns(); ++columnCounter) {
+				columnAnalyses[columnCounter].isValid = position.isValidPlay(columnCounter);
+				columnAnalyses[columnCounter].score = INT_MIN;
+				columnAnalyses[columnCounter].nodesSearched = 0;
+			}
+
+			//Without a time budget only the last depth is searched, otherwise one ply deeper at a time until the budget runs out
+			this->depthReached = 0;
+			int firstDepth = this->moveTimeBudgetInMilliseconds > 0 ? 1 : maximumDepth;
+			for (this->searchDepth = firstDepth; this->searchDepth <= maximumDepth; ++this->searchDepth) {
+
+				if (!analyzeColumns(position, columnAnalyses)) {
+					break;
 				}
+
+				this->depthReached = this->searchDepth;
+				if (this->moveTimeBudgetInMilliseconds > 0 && std::chrono::steady_clock::now() >= this->searchDeadline) {
+					break;
+				}
+			}
+
+			recordSearchStatistics(false);
+			return columnAnalyses;
+		}
+
+		//Search the computer moves on another task arena, for example one shared with the rest of the program. The arena has
+		//to outlive the game. Anything running on the current arena is cancelled first.
+		void setSearchArena(tbb::task_arena& searchArena) {
+
+			stopBackgroundSearch();
+			this->searchArena = &searchArena;
+		}
+
+		//Progress of the search for a requested computer move, or the results of the last computer move once it is played
+		struct SearchProgress {
+			bool moveIsPending;
+			int depthReached;
+			long long nodesSearched;
+		};
+
+		SearchProgress getComputerMoveProgress() const {
+
+			SearchProgress searchProgress;
+			searchProgress.moveIsPending = this->computerMoveInProgress.load();
+			if (searchProgress.moveIsPending) {
+				searchProgress.depthReached = this->depthCompletedInSearch.load();
+				searchProgress.nodesSearched = this->nodesSearched.load();
+			}
+			else {
+				searchProgress.depthReached = this->depthReached;
+				searchProgress.nodesSearched = this->searchStatsForLastMove.nodesSearched;
+			}
+
+			return searchProgress;
+		}
+
+		//Drop the user's coin without the computer replying. The reply is asked for with requestComputerMove.
+		//Returns false if the game is over, the computer is to move or the column is full.
+		bool playUserMove(int dropInColumn) {
+
+			if (this->gameIsOver || this->computerToMove || !this->gameBoard.isValidPlay(dropInColumn)) {
+				return false;
+			}
+
+			stopBackgroundSearch();
+			this->gameBoard.dropCoin(dropInColumn, true);
+			if (wasWinningPlay(dropInColumn) || isGameBoardFull()) {
+				endTheGame(true);
+			}
+			else {
+				this->computerToMove = true;
 			}
 
 			return true;
 		}
+
+		//Search for the computer's reply to the user's move on the search arena and return straight away. The future holds the
+		//column played once the move is on the board, or -1 if there was no move to make or the search was cancelled.
+		//The callback, if any, is called with the same column on the search thread and must not call back into the game.
+		//The game must be left alone until the move is played, apart from the progress and cancelComputerMove.
+		std::shared_future<int> requestComputerMove(std::function<void(int)> onComputerMove = std::function<void(int)>()) {
+
+			std::shared_ptr<std::promise<int> > computerMove = std::make_shared<std::promise<int> >();
+			std::shared_future<int> computerMoveFuture = computerMove->get_future().share();
+			if (this->gameIsOver || !this->computerToMove || this->computerMoveInProgress) {
+				computerMove->set_value(-1);
+				if (onComputerMove) {
+					onComputerMove(-1);
+				}
+				return computerMoveFuture;
+			}
+
+			stopBackgroundSearch();
+			this->computerMoveInProgress = true;
+			this->backgroundSearchStarted = true;
+			this->searchArena->enqueue(this->backgroundSearchGroup.defer([this, computerMove, onComputerMove] {
+				searchComputerMoveInBackground(computerMove, onComputerMove);
+			}));
+
+			return computerMoveFuture;
+		}
+
+		//Check if a requested computer move is still being searched
+		bool isComputerMovePending() const {
+			return this->computerMoveInProgress.load();
+		}
+
+		//Stop the search for a requested computer move and wait for it to stop. The move is not played and can be requested again.
+		void cancelComputerMove() {
+
+			if (this->computerMoveInProgress) {
+				stopBackgroundSearch();
+			}
+		}
+
+		//User method to drop a coin into one of the columns and let the computer reply
+		void dropCoin(int dropInColumn) {
+
+			if (playUserMove(dropInColumn) && !this->gameIsOver) {
+
+				//Make a move to best counter the user move
+				playComputerMove(counterUserMove());
+				if (!this->gameIsOver && this->ponderingEnabled) {
+					startPondering();
+				}
+			}
+		}
+
+		//Method to check if the board has been filled and play cannot continue
+		bool isGameBoardFull() {
+			return this->gameBoard.isFull();
+		}
 	};
 
+	//Game on a board with dimensions chosen at run time
+	typedef BasicConnectFourGame<> ConnectFourGame;
+
+	//Games on boards of the common sizes
+	typedef BasicConnectFourGame<6, 7> StandardConnectFourGame;
+	typedef BasicConnectFourGame<7, 8> LargeConnectFourGame;
+	typedef BasicConnectFourGame<8, 9> ExtraLargeConnectFourGame;
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,349 @@
+#ifndef ENDGAMESOLVER
+#define ENDGAMESOLVER
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "GameSlot.hpp"
+
+namespace controller {
+
+	//Exact solver for positions near the end of a game. It searches every line to the end of the game with alpha-beta on
+	//bitboards and proves whether the player to move wins, draws or loses and how many moves it takes. Only boards that fit
+	//on a 64 bit board with a spare bit on top of each column can be solved.
+	class EndgameSolver {
+
+	public:
+
+		enum class Outcome { win, draw, loss };
+
+		//Result for the player to move. The moves to the end count the coins of both players up to the winning coin or the full board.
+		struct Solution {
+			Outcome outcome;
+			int movesToEnd;
+			int bestMove;
+		};
+
+	private:
+
+		//Constants
+		const static int BITS_IN_BITBOARD = 64;
+		const static int DEFAULT_TABLE_SIZE_IN_BITS = 20;
+		const static int MAXIMUM_NUMBER_OF_COLUMNS = BITS_IN_BITBOARD / 2;
+
+		int numberOfRows, numberOfColumns, numberOfSlots;
+		std::uint64_t bottomMask, boardMask;
+		std::vector<int> moveOrder;
+		long long nodesSearched;
+
+		//Upper bounds on the score of positions already searched. Scores only depend on the number of coins on the board when
+		//the game ends, so entries stay valid from one position to the next.
+		std::vector<std::uint64_t> tableKeys;
+		std::vector<signed char> tableUpperBounds;
+		std::uint64_t tableIndexMask;
+
+		//Bitboards use the same layout as the game board. Each column takes one bit per row from the bottom up plus a sentinel bit.
+		std::uint64_t getColumnMask(int column) const {
+			return ((std::uint64_t(1) << this->numberOfRows) - 1) << (column * (this->numberOfRows + 1));
+		}
+
+		static int countCoins(std::uint64_t coins) {
+
+			int numberOfCoins = 0;
+			for (; coins != 0; coins &= coins - 1) {
+				++numberOfCoins;
+			}
+			return numberOfCoins;
+		}
+
+		//Empty slots that would complete four in a row for the coins if they were filled
+		std::uint64_t getWinningSlots(std::uint64_t coins, std::uint64_t mask) const {
+
+			//Vertical
+			std::uint64_t winningSlots = (coins << 1) & (coins << 2) & (coins << 3);
+
+			//Horizontal and the two diagonal directions, with the empty slot at any of the four places in the row
+			const int directionShifts[] = { this->numberOfRows + 1, this->numberOfRows, this->numberOfRows + 2 };
+			for (int shift : directionShifts) {
+
+				std::uint64_t pairs = (coins << shift) & (coins << (2 * shift));
+				winningSlots |= pairs & (coins << (3 * shift));
+				winningSlots |= pairs & (coins >> shift);
+
+				pairs = (coins >> shift) & (coins >> (2 * shift));
+				winningSlots |= pairs & (coins << shift);
+				winningSlots |= pairs & (coins >> (3 * shift));
+			}
+
+			return winningSlots & (this->boardMask ^ mask);
+		}
+
+		//Slots where the next coin in each column would land
+		std::uint64_t getPlayableSlots(std::uint64_t mask) const {
+			return (mask + this->bottomMask) & this->boardMask;
+		}
+
+		//Moves that do not let the opponent win with their next coin. Returns zero if every move does.
+		std::uint64_t getNonLosingMoves(std::uint64_t coins, std::uint64_t mask) const {
+
+			std::uint64_t playableSlots = getPlayableSlots(mask);
+			std::uint64_t opponentWinningSlots = getWinningSlots(coins ^ mask, mask);
+			std::uint64_t forcedMoves = playableSlots & opponentWinningSlots;
+			if (forcedMoves != 0) {
+
+				//The opponent has two threats and only one of them can be blocked
+				if ((forcedMoves & (forcedMoves - 1)) != 0) {
+					return 0;
+				}
+				playableSlots = forcedMoves;
+			}
+
+			//Never play right below a slot that wins for the opponent
+			return playableSlots & ~(opponentWinningSlots >> 1);
+		}
+
+		std::uint64_t getTableIndex(std::uint64_t key) const {
+
+			key = (key ^ (key >> 31)) * 0x9E3779B97F4A7C15ULL;
+			return (key ^ (key >> 29)) & this->tableIndexMask;
+		}
+
+		//Score of a position for the player to move, who cannot win with the next coin. A win with the t-th coin on the board
+		//scores one more than the number of slots minus t, a loss the same negated and a draw zero. Scores at or below alpha and
+		//at or above beta only need to be bounds.
+		int negamax(std::uint64_t coins, std::uint64_t mask, int coinsPlayed, int alpha, int beta) {
+
+			++this->nodesSearched;
+
+			//The player cannot win with the last coin and the opponent has none left
+			if (coinsPlayed >= this->numberOfSlots - 1) {
+				return 0;
+			}
+
+			std::uint64_t nonLosingMoves = getNonLosingMoves(coins, mask);
+			if (nonLosingMoves == 0) {
+				return -(this->numberOfSlots - 1 - coinsPlayed);
+			}
+
+			//Neither player can win with the last two coins
+			if (coinsPlayed >= this->numberOfSlots - 2) {
+				return 0;
+			}
+
+			//The opponent cannot win with their next coin, so the earliest loss is with the one after
+			int minimumScore = -(this->numberOfSlots - 3 - coinsPlayed);
+			if (alpha < minimumScore) {
+				alpha = minimumScore;
+				if (alpha >= beta) {
+					return alpha;
+				}
+			}
+
+			//The player cannot win with this coin, so the earliest win is with the next one
+			std::uint64_t key = coins + mask + this->bottomMask;
+			std::uint64_t tableIndex = getTableIndex(key);
+			int maximumScore = this->numberOfSlots - 2 - coinsPlayed;
+			if (this->tableKeys[tableIndex] == key) {
+				maximumScore = this->tableUpperBounds[tableIndex];
+			}
+			if (beta > maximumScore) {
+				beta = maximumScore;
+				if (alpha >= beta) {
+					return beta;
+				}
+			}
+
+			//Try the moves that leave the most threats first. Moves with as many threats keep the center-first order.
+			std::uint64_t orderedMoves[MAXIMUM_NUMBER_OF_COLUMNS];
+			int moveThreats[MAXIMUM_NUMBER_OF_COLUMNS], numberOfMoves = 0;
+			for (int column : this->moveOrder) {
+
+				std::uint64_t move = nonLosingMoves & getColumnMask(column);
+				if (move != 0) {
+
+					int threats = countCoins(getWinningSlots(coins | move, mask));
+					int moveCounter = numberOfMoves++;
+					for (; moveCounter > 0 && moveThreats[moveCounter - 1] < threats; --moveCounter) {
+						orderedMoves[moveCounter] = orderedMoves[moveCounter - 1];
+						moveThreats[moveCounter] = moveThreats[moveCounter - 1];
+					}
+					orderedMoves[moveCounter] = move;
+					moveThreats[moveCounter] = threats;
+				}
+			}
+
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+
+				std::uint64_t nextMask = mask | orderedMoves[moveCounter];
+				int score = -negamax(coins ^ mask, nextMask, coinsPlayed + 1, -beta, -alpha);
+				if (score >= beta) {
+					return score;
+				}
+				if (score > alpha) {
+					alpha = score;
+				}
+			}
+
+			this->tableKeys[tableIndex] = key;
+			this->tableUpperBounds[tableIndex] = static_cast<signed char>(alpha);
+			return alpha;
+		}
+
+		//Exact score by narrowing the range of possible scores with null window searches
+		int getExactScore(std::uint64_t coins, std::uint64_t mask, int coinsPlayed) {
+
+			int minimumScore = -(this->numberOfSlots - coinsPlayed), maximumScore = this->numberOfSlots + 1 - coinsPlayed;
+			while (minimumScore < maximumScore) {
+
+				//Try scores near zero first since they are the quickest to prove or refute
+				int medianScore = minimumScore + (maximumScore - minimumScore) / 2;
+				if (medianScore <= 0 && minimumScore / 2 < medianScore) {
+					medianScore = minimumScore / 2;
+				}
+				else if (medianScore >= 0 && maximumScore / 2 > medianScore) {
+					medianScore = maximumScore / 2;
+				}
+
+				int score = negamax(coins, mask, coinsPlayed, medianScore, medianScore + 1);
+				if (score <= medianScore) {
+					maximumScore = score;
+				}
+				else {
+					minimumScore = score;
+				}
+			}
+
+			return minimumScore;
+		}
+
+		Solution getSolution(int score, int coinsPlayed, int bestMove) const {
+
+			Solution solution;
+			solution.bestMove = bestMove;
+			if (score > 0) {
+				solution.outcome = Outcome::win;
+				solution.movesToEnd = this->numberOfSlots + 1 - score - coinsPlayed;
+			}
+			else if (score < 0) {
+				solution.outcome = Outcome::loss;
+				solution.movesToEnd = this->numberOfSlots + 1 + score - coinsPlayed;
+			}
+			else {
+				solution.outcome = Outcome::draw;
+				solution.movesToEnd = this->numberOfSlots - coinsPlayed;
+			}
+
+			return solution;
+		}
+
+	public:
+
+		//Constructor with the dimensions of the boards to solve
+		EndgameSolver(int numberOfRows, int numberOfColumns) {
+
+			if (!canSolve(numberOfRows, numberOfColumns)) {
+				std::stringstream errorMessage;
+				errorMessage << "A board of " << numberOfRows << " rows and " << numberOfColumns << " columns does not fit on a bitboard.";
+				throw std::logic_error(errorMessage.str());
+			}
+
+			this->numberOfRows = numberOfRows;
+			this->numberOfColumns = numberOfColumns;
+			this->numberOfSlots = numberOfRows * numberOfColumns;
+			this->nodesSearched = 0;
+
+			this->bottomMask = 0;
+			for (int column = 0; column < numberOfColumns; ++column) {
+				this->bottomMask |= std::uint64_t(1) << (column * (numberOfRows + 1));
+			}
+			this->boardMask = this->bottomMask * ((std::uint64_t(1) << numberOfRows) - 1);
+
+			//Columns nearer the center are part of more four-in-a-row windows, so they are tried first
+			for (int column = 0; column < numberOfColumns; ++column) {
+				this->moveOrder.push_back(numberOfColumns / 2 + (1 - 2 * (column % 2)) * (column + 1) / 2);
+			}
+
+			this->tableKeys = std::vector<std::uint64_t>(std::uint64_t(1) << DEFAULT_TABLE_SIZE_IN_BITS, 0);
+			this->tableUpperBounds = std::vector<signed char>(std::uint64_t(1) << DEFAULT_TABLE_SIZE_IN_BITS, 0);
+			this->tableIndexMask = (std::uint64_t(1) << DEFAULT_TABLE_SIZE_IN_BITS) - 1;
+		}
+
+		//Check if boards of these dimensions fit on a bitboard with a sentinel bit on top of each column
+		static bool canSolve(int numberOfRows, int numberOfColumns) {
+			return numberOfColumns >= 1 && (numberOfRows + 1) * numberOfColumns <= BITS_IN_BITBOARD;
+		}
+
+		//Solve the position on the board for the player to move. The search goes to the end of the game, so it is only quick
+		//once most of the board is full.
+		template <typename GameBoard>
+		Solution solve(const GameBoard& gameBoard, bool isUserCoin) {
+
+			this->nodesSearched = 0;
+
+			//Bitboards of the coins of the player to move and of all coins
+			std::uint64_t coins = 0, mask = 0;
+			const std::vector<GameSlot>& gameSlots = gameBoard.getGameBoardVector();
+			for (int row = 0; row < this->numberOfRows; ++row) {
+				for (int column = 0; column < this->numberOfColumns; ++column) {
+
+					const GameSlot& gameSlot = gameSlots[row * this->numberOfColumns + column];
+					if (!gameSlot.isEmpty()) {
+						std::uint64_t slotBit = std::uint64_t(1) << (column * (this->numberOfRows + 1) + this->numberOfRows - 1 - row);
+						mask |= slotBit;
+						if (gameSlot.hasUserCoin() == isUserCoin) {
+							coins |= slotBit;
+						}
+					}
+				}
+			}
+
+			int coinsPlayed = countCoins(mask);
+			if (coinsPlayed == this->numberOfSlots) {
+				return getSolution(0, coinsPlayed, -1);
+			}
+
+			//A coin that wins straight away is always the best move
+			std::uint64_t playableSlots = getPlayableSlots(mask);
+			std::uint64_t winningSlots = getWinningSlots(coins, mask) & playableSlots;
+			for (int column : this->moveOrder) {
+				if ((winningSlots & getColumnMask(column)) != 0) {
+					return getSolution(this->numberOfSlots - coinsPlayed, coinsPlayed, column);
+				}
+			}
+
+			int score = getExactScore(coins, mask, coinsPlayed);
+
+			//Every move lets the opponent win with their next coin
+			std::uint64_t nonLosingMoves = getNonLosingMoves(coins, mask);
+			if (nonLosingMoves == 0) {
+				for (int column : this->moveOrder) {
+					if ((playableSlots & getColumnMask(column)) != 0) {
+						return getSolution(score, coinsPlayed, column);
+					}
+				}
+			}
+
+			//Play the first move whose position after it is worth the score to the player
+			for (int column : this->moveOrder) {
+
+				std::uint64_t move = nonLosingMoves & getColumnMask(column);
+				if (move != 0 && negamax(coins ^ mask, mask | move, coinsPlayed + 1, -score, -score + 1) <= -score) {
+					return getSolution(score, coinsPlayed, column);
+				}
+			}
+
+			return getSolution(score, coinsPlayed, -1);
+		}
+
+		//Number of positions searched by the last call to solve
+		long long getNodesSearched() const {
+			return this->nodesSearched;
+		}
+
+	};
+
+}
+
+#endif
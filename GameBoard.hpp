@@ -2,136 +2,216 @@
 #define GAMEBOARD
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include "GameSlot.hpp"
+#include "WindowTable.hpp"
 
 namespace model {
 
-	class GameBoard {
+	//Game board with its dimensions fixed at compile time, or given at run time when both template parameters are zero.
+	//Fixed dimensions turn the index arithmetic and loop bounds on the board into constants.
+	template <int Rows = 0, int Columns = 0>
+	class BasicGameBoard {
+
+		static_assert((Rows == 0) == (Columns == 0), "Either both or neither of the board dimensions are fixed");
 
 	private:
 
 		//Members
 		std::vector<GameSlot> gameBoard;
-		int numberOfRows, numberOfColumns;
-		bool forceDropAllowed;
+		std::vector<int> columnHeights;
+		std::vector<unsigned char> userCoinsInWindow, computerCoinsInWindow;
+		const WindowTable* windowTable;
+		std::uint64_t userCoins, computerCoins, positionHash, mirroredPositionHash;
+		int numberOfRows, numberOfColumns, numberOfCoins;
+		bool forceDropAllowed, bitboardFits;
 
 		//Constants for default values
 		const static int DEFAULT_NUMBER_OF_ROWS = 6;
 		const static int DEFAULT_NUMBER_OF_COLUMNS = 7;
+		const static int BITS_IN_BITBOARD = 64;
+		const static int COINS_IN_A_ROW_TO_WIN = 4;
 
-	public:
-
-		//Default constructor
-		GameBoard() {
+		//Set up column heights, the coin count and bitboards for an empty board of the required dimensions
+		void initializeBoard(int numberOfRows, int numberOfColumns, bool forceDropAllowed) {
 
-			this->gameBoard = std::vector<GameSlot>(DEFAULT_NUMBER_OF_ROWS * DEFAULT_NUMBER_OF_COLUMNS, GameSlot::GameSlot());
-			this->numberOfRows = DEFAULT_NUMBER_OF_ROWS;
-			this->numberOfColumns = DEFAULT_NUMBER_OF_COLUMNS;
-			this->forceDropAllowed = false;
-
-		}
-
-		//Constructor with required number of rows and columns
-		GameBoard(int numberOfRows, int numberOfColumns) {
+			if (Rows != 0 && (numberOfRows != Rows || numberOfColumns != Columns)) {
+				std::stringstream errorMessage;
+				errorMessage << "A board of " << numberOfRows << " rows and " << numberOfColumns << " columns does not match the fixed board size of " << Rows << " rows and " << Columns << " columns.";
+				throw std::logic_error(errorMessage.str());
+			}
 
-			this->gameBoard = std::vector<GameSlot>(numberOfRows * numberOfColumns, GameSlot::GameSlot());
 			this->numberOfRows = numberOfRows;
 			this->numberOfColumns = numberOfColumns;
-			this->forceDropAllowed = false;
+			this->forceDropAllowed = forceDropAllowed;
+			this->columnHeights = std::vector<int>(numberOfColumns, 0);
+			this->numberOfCoins = 0;
+			this->userCoins = 0;
+			this->computerCoins = 0;
+			this->positionHash = 0;
+			this->mirroredPositionHash = 0;
+
+			//Boards of the same shape share one table of four-in-a-row windows
+			this->windowTable = WindowTable::getWindowTable(numberOfRows, numberOfColumns);
+			this->userCoinsInWindow = std::vector<unsigned char>(this->windowTable->getNumberOfWindows(), 0);
+			this->computerCoinsInWindow = std::vector<unsigned char>(this->windowTable->getNumberOfWindows(), 0);
+
+			//Each column takes one bit per row plus a sentinel bit on top so that shifts do not wrap between columns
+			this->bitboardFits = (numberOfRows + 1) * numberOfColumns <= BITS_IN_BITBOARD;
 
 		}
 
-		//Constructor with a gameboard as parameter
-		GameBoard(std::vector<GameSlot> gameBoard, int numberOfRows, int numberOfColumns) {
-			this->gameBoard = gameBoard;
-			this->numberOfRows = numberOfRows;
-			this->numberOfColumns = numberOfColumns;
-			this->forceDropAllowed = true;
+		//Check if every slot has a bit on the bitboard
+		bool usesBitboard() const {
+			return Rows != 0 ? (Rows + 1) * Columns <= BITS_IN_BITBOARD : this->bitboardFits;
 		}
 
-		int getNumberOfRows() {
-			return this->numberOfRows;
+		//Bit position for a slot. Columns are laid out one after the other starting from the bottom row.
+		int getBitIndex(int rowNumber, int columnNumber) const {
+			return columnNumber * (getNumberOfRows() + 1) + (getNumberOfRows() - 1 - rowNumber);
 		}
 
-		const int getNumberOfColumns() const {
-			return this->numberOfColumns;
+		//Zobrist key for a coin in a slot. Keys are derived from the slot index so that every board of the same size hashes the same way.
+		static std::uint64_t getZobristKey(int boardIndex, bool isUserCoin) {
+
+			std::uint64_t key = (static_cast<std::uint64_t>(boardIndex) * 2 + (isUserCoin ? 1 : 0) + 1) * 0x9E3779B97F4A7C15ULL;
+			key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+			return key ^ (key >> 31);
 		}
 
-		//Check if this is a valid play given the game board dimensions and coins already played
-		bool isValidPlay(int dropInColumn) const {
+		//Check if there are four coins in a row anywhere on the bitboard
+		bool hasFourInARow(std::uint64_t coins) const {
 
-			//First check if the column number is valid as per the dimensions of the game board
-			if (isValidColumn(dropInColumn)) {
+			//Shifts for vertical, horizontal and the two diagonal directions
+			const int directionShifts[] = { 1, getNumberOfRows() + 1, getNumberOfRows(), getNumberOfRows() + 2 };
 
-				//Next check if there is at least one empty slot in the column. i.e. check if the top slot is empty
-				if (isEmptyAt(dropInColumn)) {
+			for (int shift : directionShifts) {
+				std::uint64_t pairs = coins & (coins >> shift);
+				if (pairs & (pairs >> (2 * shift))) {
 					return true;
 				}
-				else {
-					return false;
-				}
-
 			}
-			else {
-				return false;
+
+			return false;
+		}
+
+		//Add or take away a coin from the counts of every window through the slot
+		void updateWindowCounts(int boardIndex, bool isUserCoin, int change) {
+
+			std::vector<unsigned char>& coinsInWindow = isUserCoin ? this->userCoinsInWindow : this->computerCoinsInWindow;
+			int numberOfWindows;
+			const int* windowIndices = this->windowTable->getWindowsContainingCell(boardIndex, numberOfWindows);
+			for (int windowCounter = 0; windowCounter < numberOfWindows; ++windowCounter) {
+				coinsInWindow[windowIndices[windowCounter]] += change;
 			}
+		}
+
+	public:
+
+		//Default constructor will use the fixed dimensions if there are any
+		BasicGameBoard() {
+
+			int numberOfRows = Rows != 0 ? Rows : DEFAULT_NUMBER_OF_ROWS;
+			int numberOfColumns = Columns != 0 ? Columns : DEFAULT_NUMBER_OF_COLUMNS;
+			this->gameBoard = std::vector<GameSlot>(numberOfRows * numberOfColumns, GameSlot());
+			initializeBoard(numberOfRows, numberOfColumns, false);
 
 		}
 
-		//Return the index corresponding to the top available position
-		int getAvailableSlot(int columnNumber) {
+		//Constructor with required number of rows and columns
+		BasicGameBoard(int numberOfRows, int numberOfColumns) {
 
-			//Make sure that this is a valid play
-			assert(isValidPlay(columnNumber));
+			this->gameBoard = std::vector<GameSlot>(numberOfRows * numberOfColumns, GameSlot());
+			initializeBoard(numberOfRows, numberOfColumns, false);
+
+		}
+
+		//Constructor with a gameboard as parameter
+		BasicGameBoard(std::vector<GameSlot> gameBoard, int numberOfRows, int numberOfColumns) {
 
-			//Find the top and bottom rows in the columns
-			int bottomRowInColumn = columnNumber + getNumberOfColumns() * (getNumberOfRows() - 1);
-			int topRowInColumn = columnNumber;
+			this->gameBoard = std::vector<GameSlot>(numberOfRows * numberOfColumns, GameSlot());
+			initializeBoard(numberOfRows, numberOfColumns, true);
 
-			//Start with bottom row and go one cell above at a time till an empty one is found
-			for (int slotCounter = bottomRowInColumn; slotCounter >= topRowInColumn; slotCounter -= getNumberOfColumns()) {
-				if (isEmptyAt(slotCounter)) {
-					return slotCounter;
+			//Replay the coins from the bottom row up so that column heights and bitboards are rebuilt
+			for (int rowNumber = numberOfRows - 1; rowNumber >= 0; --rowNumber) {
+				for (int columnNumber = 0; columnNumber < numberOfColumns; ++columnNumber) {
+					const GameSlot& gameSlot = gameBoard.at(rowNumber * numberOfColumns + columnNumber);
+					if (!gameSlot.isEmpty()) {
+						dropCoin(columnNumber, gameSlot.hasUserCoin());
+					}
 				}
 			}
+		}
 
-			//Exit the program as if it reaches here as this should never happen
-			assert(false);
+		int getNumberOfRows() const {
+			return Rows != 0 ? Rows : this->numberOfRows;
+		}
 
-			return 0;
+		int getNumberOfColumns() const {
+			return Columns != 0 ? Columns : this->numberOfColumns;
 		}
 
+		//Check if this is a valid play given the game board dimensions and coins already played
+		bool isValidPlay(int dropInColumn) const {
 
-		//Return the index corresponding to the top position with a coin
-		int getPlayedSlot(int columnNumber) {
+			//The column number must be valid as per the dimensions of the game board and the column must not be full
+			return isValidColumn(dropInColumn) && this->columnHeights[dropInColumn] < getNumberOfRows();
 
-			//Find the top and bottom rows in the columns
-			int bottomRowInColumn = columnNumber + getNumberOfColumns() * (getNumberOfRows() - 1);
-			int topRowInColumn = columnNumber;
+		}
 
-			//Start with bottom row and go one cell above at a time till an empty one is found
-			for (int slotCounter = topRowInColumn; slotCounter <= bottomRowInColumn; slotCounter += getNumberOfColumns()) {
-				if (!isEmptyAt(slotCounter)) {
-					return slotCounter;
-				}
+		//Return the index corresponding to the top available position
+		int getAvailableSlot(int columnNumber) const {
+
+			//Make sure that this is a valid play
+			assert(isValidPlay(columnNumber));
+
+			return (getNumberOfRows() - 1 - this->columnHeights[columnNumber]) * getNumberOfColumns() + columnNumber;
+		}
+
+
+		//Return the index corresponding to the top position with a coin
+		int getPlayedSlot(int columnNumber) const {
+
+			//Exit the program if the column is empty as this should never happen
+			if (this->columnHeights[columnNumber] == 0) {
+				std::cerr << "Error getting played slot in column " << columnNumber << std::endl;
+				assert(false);
 			}
 
-			//Exit the program as if it reaches here as this should never happen
-			std::cerr << "Error getting played slot in column " << columnNumber << std::endl;
-			assert(false);
+			return (getNumberOfRows() - this->columnHeights[columnNumber]) * getNumberOfColumns() + columnNumber;
+		}
+
 
-			return 0;
+		//Number of coins in a column
+		int getColumnHeight(int columnNumber) const {
+			return this->columnHeights[columnNumber];
 		}
 
+		//Number of coins on the board, kept up to date as coins are dropped and taken back
+		int getNumberOfCoins() const {
+			return this->numberOfCoins;
+		}
+
+		//Number of moves left before the board is full
+		int getNumberOfEmptySlots() const {
+			return getNumberOfRows() * getNumberOfColumns() - this->numberOfCoins;
+		}
+
+		//Check if every slot has a coin, so that no more moves can be played
+		bool isFull() const {
+			return this->numberOfCoins == getNumberOfRows() * getNumberOfColumns();
+		}
 
 		//Check if the column is valid according to the board dimensions
 		bool isValidColumn(int columnNumber) const {
 
-			if (columnNumber >= 0 && columnNumber < this->numberOfColumns) {
+			if (columnNumber >= 0 && columnNumber < getNumberOfColumns()) {
 				return true;
 			}
 			else {
@@ -140,23 +220,23 @@ namespace model {
 		}
 
 		//Return the row number starting with zero
-		int getRowNumber(int boardIndex) {
+		int getRowNumber(int boardIndex) const {
 
-			return boardIndex / this->numberOfColumns;
+			return boardIndex / getNumberOfColumns();
 
 		}
 
 		//Return the column number starting with zero
-		int getColumnNumber(int boardIndex) {
+		int getColumnNumber(int boardIndex) const {
 
-			return boardIndex % this->numberOfColumns;
+			return boardIndex % getNumberOfColumns();
 
 		}
 
 		//Return index corresponding to row and column numbers passed in as parameters
-		int getBoardIndex(int rowNumber, int columnNumber) {
-			if (rowNumber <= this->numberOfRows - 1 && columnNumber <= this->numberOfColumns - 1) {
-				return rowNumber * this->numberOfColumns + columnNumber;
+		int getBoardIndex(int rowNumber, int columnNumber) const {
+			if (rowNumber <= getNumberOfRows() - 1 && columnNumber <= getNumberOfColumns() - 1) {
+				return rowNumber * getNumberOfColumns() + columnNumber;
 			}
 			else {
 				std::stringstream errorMessage;
@@ -165,74 +245,154 @@ namespace model {
 			}
 		}
 
-		int getDiagonalCellToRightGoingUp(int boardIndex) {
+		bool isEmptyAt(int boardIndex) const {
 
-			int rowNumber = getRowNumber(boardIndex);
-			int columnNumber = getColumnNumber(boardIndex);
-			if (rowNumber != 0 && columnNumber != this->numberOfColumns - 1) {
-				return getBoardIndex(rowNumber - 1, columnNumber + 1);
-			}
-			else {
-				std::stringstream errorMessage;
-				errorMessage << "Cell at index " << boardIndex << " is on row " << rowNumber << " and column " << columnNumber << ". Cannot get a diagonal cell going right and up.";
-				throw std::logic_error(errorMessage.str());
-			}
+			return this->gameBoard[boardIndex].isEmpty();
 
 		}
 
-		int getDiagonalCellToRightGoingDown(int boardIndex) {
+		const GameSlot& getGameSlot(int boardIndex) const {
 
-			int rowNumber = getRowNumber(boardIndex);
-			int columnNumber = getColumnNumber(boardIndex);
-			if (rowNumber != this->numberOfRows - 1 && columnNumber != this->numberOfColumns - 1) {
-				return getBoardIndex(rowNumber + 1, columnNumber + 1);
-			}
-			else {
-				std::stringstream errorMessage;
-				errorMessage << "Cell at index " << boardIndex << " is on row " << rowNumber << " and column " << columnNumber << ". Cannot get a diagonal cell going right and down.";
-				throw std::logic_error(errorMessage.str());
-			}
+			return this->gameBoard[boardIndex];
 
 		}
 
-		bool isEmptyAt(int boardIndex) const {
+		//Hash of the coins on the board, updated as coins are dropped
+		std::uint64_t getPositionHash() const {
+			return this->positionHash;
+		}
 
-			if (this->gameBoard.at(boardIndex).isEmpty()) {
-				return true;
-			}
-			else {
-				return false;
+		//Hash the board would have with every coin moved to the mirror image of its column
+		std::uint64_t getMirroredPositionHash() const {
+			return this->mirroredPositionHash;
+		}
+
+		//Column in the same place counting from the other side of the board
+		int getMirroredColumn(int columnNumber) const {
+			return getNumberOfColumns() - 1 - columnNumber;
+		}
+
+		//Check if the board looks the same reflected left to right, so that a move and its mirror image are worth the same
+		bool isMirrorSymmetric() const {
+
+			for (int columnNumber = 0; columnNumber < getNumberOfColumns() / 2; ++columnNumber) {
+
+				int mirroredColumn = getMirroredColumn(columnNumber);
+				if (this->columnHeights[columnNumber] != this->columnHeights[mirroredColumn]) {
+					return false;
+				}
+
+				for (int rowNumber = getNumberOfRows() - this->columnHeights[columnNumber]; rowNumber < getNumberOfRows(); ++rowNumber) {
+					if (this->gameBoard[rowNumber * getNumberOfColumns() + columnNumber].hasUserCoin() !=
+						this->gameBoard[rowNumber * getNumberOfColumns() + mirroredColumn].hasUserCoin()) {
+						return false;
+					}
+				}
 			}
 
+			return true;
 		}
 
-		GameSlot& getGameSlot(int boardIndex) {
+		//Four-in-a-row windows of one direction that contain the slot. Directions are numbered horizontal, vertical, positive slope and negative slope.
+		const int* getWindowsContainingSlot(int boardIndex, int direction, int& numberOfWindows) const {
+			return this->windowTable->getWindowsContainingCell(boardIndex, direction, numberOfWindows);
+		}
 
-			return this->gameBoard.at(boardIndex);
+		//Four-in-a-row windows in every direction that contain the slot
+		const int* getWindowsContainingSlot(int boardIndex, int& numberOfWindows) const {
+			return this->windowTable->getWindowsContainingCell(boardIndex, numberOfWindows);
+		}
 
+		//Number of user coins in a four-in-a-row window, kept up to date as coins are dropped and removed
+		int getUserCoinsInWindow(int windowIndex) const {
+			return this->userCoinsInWindow[windowIndex];
+		}
+
+		//Number of computer coins in a four-in-a-row window, kept up to date as coins are dropped and removed
+		int getComputerCoinsInWindow(int windowIndex) const {
+			return this->computerCoinsInWindow[windowIndex];
+		}
+
+		//Check if a coin of the player in an empty slot would complete four in a row. Any window through the slot that already
+		//holds three of the player's coins has the slot as its only empty place.
+		bool completesFourInARow(int boardIndex, bool isUserCoin) const {
+
+			const std::vector<unsigned char>& coinsInWindow = isUserCoin ? this->userCoinsInWindow : this->computerCoinsInWindow;
+			int numberOfWindows;
+			const int* windowIndices = this->windowTable->getWindowsContainingCell(boardIndex, numberOfWindows);
+			for (int windowCounter = 0; windowCounter < numberOfWindows; ++windowCounter) {
+				if (coinsInWindow[windowIndices[windowCounter]] == COINS_IN_A_ROW_TO_WIN - 1) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		//Check if dropping a coin of the player into the column would win the game
+		bool isWinningDrop(int columnNumber, bool isUserCoin) const {
+			return isValidPlay(columnNumber) && completesFourInARow(getAvailableSlot(columnNumber), isUserCoin);
+		}
+
+		//Check if a coin dropped into the column would let the opponent of the player win by dropping a coin on top of it
+		bool givesOpponentWinAbove(int columnNumber, bool isUserCoin) const {
+			return isValidPlay(columnNumber) && this->columnHeights[columnNumber] + 1 < getNumberOfRows() &&
+				completesFourInARow(getAvailableSlot(columnNumber) - getNumberOfColumns(), !isUserCoin);
 		}
 
 		const std::vector<GameSlot>& getGameBoardVector() const {
 			return this->gameBoard;
 		}
 
-		void forceDropCoin(int columnNumber, bool isUserCoin) {
-
-			if (this->forceDropAllowed) {
+		//Drop a coin into the top available slot of a column
+		void dropCoin(int columnNumber, bool isUserCoin) {
 
-				//Find the top and bottom rows in the columns
-				int bottomRowInColumn = columnNumber + this->numberOfColumns * (this->numberOfRows - 1);
-				int topRowInColumn = columnNumber;
+			//Make sure that this is a valid play
+			assert(isValidPlay(columnNumber));
 
-				//Start with bottom row and go one cell above at a time till an empty one is found
-				for (int slotCounter = bottomRowInColumn; slotCounter >= topRowInColumn; slotCounter -= this->numberOfColumns) {
-					if (this->gameBoard.at(slotCounter).isEmpty()) {
-						GameSlot& gameSlot = this->gameBoard.at(slotCounter);
-						gameSlot.putCoin(isUserCoin);
-						break;
-					}
+			int rowNumber = getNumberOfRows() - 1 - this->columnHeights[columnNumber];
+			int boardIndex = rowNumber * getNumberOfColumns() + columnNumber;
+			this->gameBoard[boardIndex].putCoin(isUserCoin);
+			++this->columnHeights[columnNumber];
+			++this->numberOfCoins;
+			this->positionHash ^= getZobristKey(boardIndex, isUserCoin);
+			this->mirroredPositionHash ^= getZobristKey(rowNumber * getNumberOfColumns() + getMirroredColumn(columnNumber), isUserCoin);
+			updateWindowCounts(boardIndex, isUserCoin, 1);
+
+			if (usesBitboard()) {
+				std::uint64_t slotBit = std::uint64_t(1) << getBitIndex(rowNumber, columnNumber);
+				if (isUserCoin) {
+					this->userCoins |= slotBit;
+				}
+				else {
+					this->computerCoins |= slotBit;
 				}
+			}
+		}
 
+		//Take back the top coin in a column so that a simulated move can be undone
+		void removeCoin(int columnNumber) {
+
+			int boardIndex = getPlayedSlot(columnNumber);
+			bool isUserCoin = this->gameBoard[boardIndex].hasUserCoin();
+			this->gameBoard[boardIndex].removeCoin();
+			--this->columnHeights[columnNumber];
+			--this->numberOfCoins;
+			this->positionHash ^= getZobristKey(boardIndex, isUserCoin);
+			this->mirroredPositionHash ^= getZobristKey(boardIndex - columnNumber + getMirroredColumn(columnNumber), isUserCoin);
+			updateWindowCounts(boardIndex, isUserCoin, -1);
+
+			if (usesBitboard()) {
+				std::uint64_t slotBit = std::uint64_t(1) << getBitIndex(getRowNumber(boardIndex), columnNumber);
+				this->userCoins &= ~slotBit;
+				this->computerCoins &= ~slotBit;
+			}
+		}
+
+		void forceDropCoin(int columnNumber, bool isUserCoin) {
+
+			if (this->forceDropAllowed) {
+				dropCoin(columnNumber, isUserCoin);
 			}
 			else {
 				throw std::logic_error("Force drop is not allowed for this game board");
@@ -241,8 +401,39 @@ namespace model {
 
 		}
 
+		//Check if the top coin in the column completes four in a row for the player who dropped it
+		bool isWinningPlay(int columnPlayed) const {
+
+			int playedSlot = getPlayedSlot(columnPlayed);
+			bool isUserCoin = this->gameBoard[playedSlot].hasUserCoin();
+
+			if (usesBitboard()) {
+				return hasFourInARow(isUserCoin ? this->userCoins : this->computerCoins);
+			}
+
+			//Boards too large for the bitboard look for a full window through the dropped coin
+			const std::vector<unsigned char>& coinsInWindow = isUserCoin ? this->userCoinsInWindow : this->computerCoinsInWindow;
+			int numberOfWindows;
+			const int* windowIndices = this->windowTable->getWindowsContainingCell(playedSlot, numberOfWindows);
+			for (int windowCounter = 0; windowCounter < numberOfWindows; ++windowCounter) {
+				if (coinsInWindow[windowIndices[windowCounter]] == COINS_IN_A_ROW_TO_WIN) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
 	};
 
+	//Board with dimensions chosen at run time
+	typedef BasicGameBoard<> GameBoard;
+
+	//Boards of the common sizes
+	typedef BasicGameBoard<6, 7> StandardGameBoard;
+	typedef BasicGameBoard<7, 8> LargeGameBoard;
+	typedef BasicGameBoard<8, 9> ExtraLargeGameBoard;
+
 }
 
 #endif
\ No newline at end of file
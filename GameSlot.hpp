@@ -37,6 +37,17 @@ public:
 		}
 	}
 
+	//Take the coin out of the slot. This is allowed only if the slot has a coin
+	void removeCoin() {
+
+		//If the slot is empty then this is an unexpected error
+		if (this->slotState == SlotStates::empty) {
+			throw std::logic_error("The slot is empty");
+		}
+
+		this->slotState = SlotStates::empty;
+	}
+
 	//Check if slot is empty
 	bool isEmpty() const {
 
@@ -48,11 +59,11 @@ public:
 		}
 	}
 
-	bool hasUserCoin() {
+	bool hasUserCoin() const {
 		return this->slotState == SlotStates::hasUserCoin;
 	}
 
-	bool hasComputerCoin() {
+	bool hasComputerCoin() const {
 		return this->slotState == SlotStates::hasComputerCoin;
 	}
 
@@ -0,0 +1,457 @@
+#ifndef MONTECARLOTREESEARCH
+#define MONTECARLOTREESEARCH
+
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GameSlot.hpp"
+
+namespace controller {
+
+	//Monte Carlo tree search for boards too large for the minimax search to see far enough. Instead of scoring positions
+	//with a heuristic at a fixed depth, it plays quick games to the end from the leaves of a tree that grows towards the
+	//moves that win most often. All worker threads share one tree. The statistics of each node are atomic counters and a
+	//visit is counted on the way down, so a move that is still being played out looks like a loss to the other threads and
+	//they spread out over the tree. Nodes come from a pool that is allocated once and reused from search to search.
+	class MonteCarloTreeSearch {
+
+	public:
+
+		//Result of a search. The playouts on each slot of the task arena show how evenly the work was spread across threads.
+		struct Result {
+			int bestMove, maximumDepthReached;
+			long long playouts;
+			std::vector<long long> playoutsPerThread;
+		};
+
+	private:
+
+		//Constants
+		const static int DEFAULT_NODE_POOL_SIZE = 1 << 20;
+		const static int DEFAULT_SEED = 1;
+		const static int VISITS_BEFORE_EXPANSION = 2;
+		const static int PLAYOUTS_BETWEEN_DEADLINE_CHECKS = 64;
+		const static int CACHE_LINE_SIZE = 64;
+		const static int UNEXPANDED = -2;
+		const static int EXPANDING = -1;
+		const static int SCORE_FOR_WIN = 2;
+		const static int SCORE_FOR_DRAW = 1;
+		const static int BORDER_WIDTH = 3;
+		const static signed char BORDER = -1;
+		const static signed char EMPTY = 0;
+		const static signed char PLAYER_TO_MOVE = 1;
+		const static signed char OPPONENT = 2;
+		static constexpr double DEFAULT_EXPLORATION_CONSTANT = 1.0;
+
+		//Node of the search tree for the position after a move. Visits and scores count from the point of view of the player who
+		//made the move, with two points for a win and one for a draw. The children of a node sit next to each other in the pool.
+		struct Node {
+			std::atomic<int> visits, score, firstChild;
+			short column, numberOfChildren;
+		};
+
+		//Board a worker plays out games on, with one byte per slot
+		struct Playout {
+			std::vector<signed char> slots;
+			std::vector<int> columnHeights, openColumns, path;
+			int numberOfCoins, numberOfOpenColumns;
+			std::uint64_t randomState;
+		};
+
+		//Work done on one slot of the task arena during a search. Only the thread in the slot updates it.
+		struct ThreadCounters {
+			long long playouts;
+			int maximumDepthReached;
+			char padding[CACHE_LINE_SIZE];
+		};
+
+		int numberOfRows, numberOfColumns, numberOfSlots, columnStride, nodePoolSize;
+		double explorationConstant;
+		std::uint64_t seed;
+		std::vector<int> moveOrder;
+		std::unique_ptr<Node[]> nodePool;
+		std::atomic<int> nodesInUse;
+		Playout rootPosition;
+		std::vector<Playout> workerPlayouts;
+		std::vector<ThreadCounters> threadCounters;
+
+		//Random numbers for the playouts from a xorshift generator, which is a few instructions per number
+		static int getRandomNumber(std::uint64_t& randomState, int range) {
+
+			randomState ^= randomState << 13;
+			randomState ^= randomState >> 7;
+			randomState ^= randomState << 17;
+			return static_cast<int>(((randomState >> 32) * static_cast<std::uint64_t>(range)) >> 32);
+		}
+
+		//Slots are stored column by column from the bottom up, with a border of slots that belong to neither player around the
+		//board so that lines can be followed without checking the edges
+		int getSlotIndex(int column, int row) const {
+			return (column + BORDER_WIDTH) * this->columnStride + row + BORDER_WIDTH;
+		}
+
+		//Count the player's coins in a line from a slot, not counting the slot itself
+		static int countCoinsInLine(const signed char* slot, int step, signed char player) {
+
+			int numberOfCoins = 0;
+			for (slot += step; numberOfCoins < 3 && *slot == player; slot += step) {
+				++numberOfCoins;
+			}
+			return numberOfCoins;
+		}
+
+		//Check if a coin of the player in the next free slot of the column makes four in a row. The slot does not have to be filled.
+		bool isWinningDrop(const Playout& playout, int column, signed char player) const {
+
+			const signed char* slot = &playout.slots[getSlotIndex(column, playout.columnHeights[column])];
+			int stride = this->columnStride;
+			return countCoinsInLine(slot, -1, player) >= 3 ||
+				countCoinsInLine(slot, -stride, player) + countCoinsInLine(slot, stride, player) >= 3 ||
+				countCoinsInLine(slot, -stride - 1, player) + countCoinsInLine(slot, stride + 1, player) >= 3 ||
+				countCoinsInLine(slot, -stride + 1, player) + countCoinsInLine(slot, stride - 1, player) >= 3;
+		}
+
+		//Drop a coin and take the column out of the open columns once it is full
+		void dropCoin(Playout& playout, int openColumnIndex, signed char player) const {
+
+			int column = playout.openColumns[openColumnIndex];
+			playout.slots[getSlotIndex(column, playout.columnHeights[column]++)] = player;
+			++playout.numberOfCoins;
+			if (playout.columnHeights[column] == this->numberOfRows) {
+				playout.openColumns[openColumnIndex] = playout.openColumns[--playout.numberOfOpenColumns];
+			}
+		}
+
+		int findOpenColumn(const Playout& playout, int column) const {
+			return static_cast<int>(std::find(playout.openColumns.begin(), playout.openColumns.begin() + playout.numberOfOpenColumns, column) - playout.openColumns.begin());
+		}
+
+		//Play the game out from the position with the player to move and return the winner, or empty for a draw. Each coin wins
+		//if it can, blocks the opponent if it has to and is random otherwise, which costs a few checks per coin but makes the
+		//results of the playouts much closer to those of real games than purely random coins.
+		signed char playOut(Playout& playout, signed char player) const {
+
+			while (playout.numberOfOpenColumns > 0) {
+
+				signed char opponent = PLAYER_TO_MOVE + OPPONENT - player;
+				int openColumnIndex = -1;
+				for (int columnCounter = 0; columnCounter < playout.numberOfOpenColumns; ++columnCounter) {
+					if (isWinningDrop(playout, playout.openColumns[columnCounter], player)) {
+						return player;
+					}
+					else if (openColumnIndex < 0 && isWinningDrop(playout, playout.openColumns[columnCounter], opponent)) {
+						openColumnIndex = columnCounter;
+					}
+				}
+
+				if (openColumnIndex < 0) {
+					openColumnIndex = getRandomNumber(playout.randomState, playout.numberOfOpenColumns);
+				}
+				dropCoin(playout, openColumnIndex, player);
+				player = opponent;
+			}
+
+			return EMPTY;
+		}
+
+		//Take nodes for the children of a node from the pool. Returns false, and the node stays a leaf, if the pool is used up.
+		bool expandNode(Node& node, const Playout& playout) {
+
+			//The count stops growing once the pool is used up so that it cannot overflow in a long search
+			if (this->nodesInUse.load(std::memory_order_relaxed) + playout.numberOfOpenColumns > this->nodePoolSize) {
+				return false;
+			}
+
+			int firstChild = this->nodesInUse.fetch_add(playout.numberOfOpenColumns, std::memory_order_relaxed);
+			if (firstChild + playout.numberOfOpenColumns > this->nodePoolSize) {
+				return false;
+			}
+
+			//Columns nearer the center are tried first when children have the same statistics
+			int numberOfChildren = 0;
+			for (int column : this->moveOrder) {
+				if (playout.columnHeights[column] < this->numberOfRows) {
+					Node& child = this->nodePool[firstChild + numberOfChildren++];
+					child.visits.store(0, std::memory_order_relaxed);
+					child.score.store(0, std::memory_order_relaxed);
+					child.firstChild.store(UNEXPANDED, std::memory_order_relaxed);
+					child.column = static_cast<short>(column);
+					child.numberOfChildren = 0;
+				}
+			}
+
+			node.numberOfChildren = static_cast<short>(numberOfChildren);
+			node.firstChild.store(firstChild, std::memory_order_release);
+			return true;
+		}
+
+		//Child with the best upper confidence bound on its score. Children not visited yet come first.
+		int selectChild(const Node& node, int firstChild) const {
+
+			double logParentVisits = std::log(static_cast<double>(std::max(1, node.visits.load(std::memory_order_relaxed))));
+			int bestChild = firstChild;
+			double bestValue = -1;
+			for (int child = firstChild; child < firstChild + node.numberOfChildren; ++child) {
+
+				int visits = this->nodePool[child].visits.load(std::memory_order_relaxed);
+				if (visits == 0) {
+					return child;
+				}
+
+				double value = this->nodePool[child].score.load(std::memory_order_relaxed) / (2.0 * visits) +
+					this->explorationConstant * std::sqrt(logParentVisits / visits);
+				if (value > bestValue) {
+					bestValue = value;
+					bestChild = child;
+				}
+			}
+
+			return bestChild;
+		}
+
+		//Walk down the tree from the root, adding a visit to each node on the way, grow it by one node's children, play the game
+		//out from there and add the result to every node on the path
+		void runIteration(Playout& playout, ThreadCounters& threadCounters) {
+
+			const Playout& rootPlayout = this->rootPosition;
+			std::copy(rootPlayout.slots.begin(), rootPlayout.slots.end(), playout.slots.begin());
+			std::copy(rootPlayout.columnHeights.begin(), rootPlayout.columnHeights.end(), playout.columnHeights.begin());
+			std::copy(rootPlayout.openColumns.begin(), rootPlayout.openColumns.end(), playout.openColumns.begin());
+			playout.numberOfCoins = rootPlayout.numberOfCoins;
+			playout.numberOfOpenColumns = rootPlayout.numberOfOpenColumns;
+
+			int nodeIndex = 0, depth = 0;
+			signed char player = PLAYER_TO_MOVE, winner = EMPTY;
+			bool gameIsOver = false;
+			this->nodePool[0].visits.fetch_add(1, std::memory_order_relaxed);
+
+			while (true) {
+
+				Node& node = this->nodePool[nodeIndex];
+				int firstChild = node.firstChild.load(std::memory_order_acquire);
+				if (firstChild == UNEXPANDED && (nodeIndex == 0 || node.visits.load(std::memory_order_relaxed) >= VISITS_BEFORE_EXPANSION)) {
+					int unexpanded = UNEXPANDED;
+					if (node.firstChild.compare_exchange_strong(unexpanded, EXPANDING) && expandNode(node, playout)) {
+						firstChild = node.firstChild.load(std::memory_order_relaxed);
+					}
+				}
+
+				//Nodes still being expanded by another thread are played out from as they are
+				if (firstChild < 0 || node.numberOfChildren == 0) {
+					break;
+				}
+
+				nodeIndex = selectChild(node, firstChild);
+				Node& child = this->nodePool[nodeIndex];
+				child.visits.fetch_add(1, std::memory_order_relaxed);
+				playout.path[depth++] = nodeIndex;
+
+				bool isWinningMove = isWinningDrop(playout, child.column, player);
+				dropCoin(playout, findOpenColumn(playout, child.column), player);
+				if (isWinningMove) {
+					winner = player;
+					gameIsOver = true;
+					break;
+				}
+				else if (playout.numberOfOpenColumns == 0) {
+					gameIsOver = true;
+					break;
+				}
+
+				player = PLAYER_TO_MOVE + OPPONENT - player;
+			}
+
+			if (!gameIsOver) {
+				winner = playOut(playout, player);
+			}
+
+			//The player to move at the root made the moves into the nodes an odd number of plies down
+			for (int pathCounter = 0; pathCounter < depth; ++pathCounter) {
+				signed char playerMoved = pathCounter % 2 == 0 ? PLAYER_TO_MOVE : OPPONENT;
+				int score = winner == EMPTY ? SCORE_FOR_DRAW : (winner == playerMoved ? SCORE_FOR_WIN : 0);
+				if (score > 0) {
+					this->nodePool[playout.path[pathCounter]].score.fetch_add(score, std::memory_order_relaxed);
+				}
+			}
+
+			++threadCounters.playouts;
+			threadCounters.maximumDepthReached = std::max(threadCounters.maximumDepthReached, depth);
+		}
+
+		//Make sure a worker has a board of the right size to play out games on
+		void preparePlayout(Playout& playout, std::uint64_t randomState) const {
+
+			playout.slots.resize((this->numberOfColumns + 2 * BORDER_WIDTH) * this->columnStride, static_cast<signed char>(BORDER));
+			playout.columnHeights.resize(this->numberOfColumns);
+			playout.openColumns.resize(this->numberOfColumns);
+			playout.path.resize(this->numberOfSlots + 1);
+			playout.randomState = randomState;
+		}
+
+	public:
+
+		//Constructor with the dimensions of the boards to search
+		MonteCarloTreeSearch(int numberOfRows, int numberOfColumns) {
+
+			this->numberOfRows = numberOfRows;
+			this->numberOfColumns = numberOfColumns;
+			this->numberOfSlots = numberOfRows * numberOfColumns;
+			this->columnStride = numberOfRows + 2 * BORDER_WIDTH;
+			this->nodePoolSize = DEFAULT_NODE_POOL_SIZE;
+			this->explorationConstant = DEFAULT_EXPLORATION_CONSTANT;
+			this->seed = DEFAULT_SEED;
+			this->nodesInUse = 0;
+
+			//Columns nearer the center are part of more four-in-a-row windows, so they are tried first
+			for (int column = 0; column < numberOfColumns; ++column) {
+				this->moveOrder.push_back(numberOfColumns / 2 + (1 - 2 * (column % 2)) * (column + 1) / 2);
+			}
+			preparePlayout(this->rootPosition, 0);
+		}
+
+		//Number of tree nodes the pool holds. The tree stops growing once they are used up, but the playouts go on.
+		void setNodePoolSize(int nodePoolSize) {
+
+			this->nodePoolSize = nodePoolSize;
+			this->nodePool.reset();
+		}
+
+		//Weight of moves that have been played out less often than others against moves that have scored well so far
+		void setExplorationConstant(double explorationConstant) {
+			this->explorationConstant = explorationConstant;
+		}
+
+		//Playouts are random but the same for the same seed when only one thread searches
+		void setSeed(std::uint64_t seed) {
+			this->seed = seed;
+		}
+
+		//Search the position on the board for the player to move and return the move played out most often. The search runs
+		//until it has played out the maximum number of games, if that is above zero, or until the deadline, or until it is
+		//cancelled. Playouts are added to the progress count in batches while the search runs. In parallel mode every thread
+		//of the current task arena searches the same tree.
+		template <typename GameBoard>
+		Result search(const GameBoard& gameBoard, bool isUserCoin, long long maximumPlayouts, std::chrono::steady_clock::time_point deadline,
+			bool parallelMode, const std::atomic<bool>& cancelled, std::atomic<long long>& playoutsCompleted) {
+
+			if (!this->nodePool) {
+				this->nodePool.reset(new Node[this->nodePoolSize]);
+			}
+
+			//Board with the coins of the player to move and the opponent, from the bottom of each column up
+			Playout& rootPlayout = this->rootPosition;
+			const std::vector<GameSlot>& gameSlots = gameBoard.getGameBoardVector();
+			rootPlayout.numberOfCoins = 0;
+			rootPlayout.numberOfOpenColumns = 0;
+			for (int column = 0; column < this->numberOfColumns; ++column) {
+
+				rootPlayout.columnHeights[column] = 0;
+				for (int row = 0; row < this->numberOfRows; ++row) {
+
+					const GameSlot& gameSlot = gameSlots[(this->numberOfRows - 1 - row) * this->numberOfColumns + column];
+					signed char player = gameSlot.isEmpty() ? EMPTY : (gameSlot.hasUserCoin() == isUserCoin ? PLAYER_TO_MOVE : OPPONENT);
+					rootPlayout.slots[getSlotIndex(column, row)] = player;
+					if (player != EMPTY) {
+						rootPlayout.columnHeights[column] = row + 1;
+						++rootPlayout.numberOfCoins;
+					}
+				}
+
+				if (rootPlayout.columnHeights[column] < this->numberOfRows) {
+					rootPlayout.openColumns[rootPlayout.numberOfOpenColumns++] = column;
+				}
+			}
+
+			Node& root = this->nodePool[0];
+			root.visits = 0;
+			root.score = 0;
+			root.firstChild = UNEXPANDED;
+			root.column = -1;
+			root.numberOfChildren = 0;
+			this->nodesInUse = 1;
+
+			//An arena that has work queued but no workers to spare borrows one more thread, which takes the slot after the last one
+			int numberOfWorkers = parallelMode ? tbb::this_task_arena::max_concurrency() : 1;
+			size_t numberOfThreads = tbb::this_task_arena::max_concurrency() + 1;
+			if (this->threadCounters.size() < numberOfThreads) {
+				this->threadCounters.resize(numberOfThreads);
+			}
+			for (ThreadCounters& threadCounters : this->threadCounters) {
+				threadCounters.playouts = 0;
+				threadCounters.maximumDepthReached = 0;
+			}
+			if (static_cast<int>(this->workerPlayouts.size()) < numberOfWorkers) {
+				this->workerPlayouts.resize(numberOfWorkers);
+			}
+
+			std::atomic<long long> playoutsStarted(0);
+			auto runWorker = [&](int worker) {
+
+				Playout& playout = this->workerPlayouts[worker];
+				preparePlayout(playout, (this->seed + worker) * 0x9E3779B97F4A7C15ULL | 1);
+				ThreadCounters& threadCounters = this->threadCounters[std::max(0, tbb::this_task_arena::current_thread_index())];
+
+				for (long long playoutCounter = 1; !cancelled.load(std::memory_order_relaxed); ++playoutCounter) {
+
+					if (maximumPlayouts > 0 && playoutsStarted.fetch_add(1, std::memory_order_relaxed) >= maximumPlayouts) {
+						break;
+					}
+
+					runIteration(playout, threadCounters);
+					if (playoutCounter % PLAYOUTS_BETWEEN_DEADLINE_CHECKS == 0) {
+						playoutsCompleted.fetch_add(PLAYOUTS_BETWEEN_DEADLINE_CHECKS, std::memory_order_relaxed);
+						if (std::chrono::steady_clock::now() >= deadline) {
+							break;
+						}
+					}
+				}
+			};
+
+			if (numberOfWorkers > 1) {
+				tbb::parallel_for(0, numberOfWorkers, runWorker, tbb::simple_partitioner());
+			}
+			else {
+				runWorker(0);
+			}
+
+			Result result;
+			result.playouts = 0;
+			result.maximumDepthReached = 0;
+			for (const ThreadCounters& threadCounters : this->threadCounters) {
+				result.playouts += threadCounters.playouts;
+				result.maximumDepthReached = std::max(result.maximumDepthReached, threadCounters.maximumDepthReached);
+				result.playoutsPerThread.push_back(threadCounters.playouts);
+			}
+
+			//The move played out most often is the one the search trusts most. Ties go to the column nearer the center.
+			result.bestMove = -1;
+			int firstChild = root.firstChild.load(), mostVisits = -1;
+			for (int child = firstChild; firstChild >= 0 && child < firstChild + root.numberOfChildren; ++child) {
+				if (this->nodePool[child].visits > mostVisits) {
+					mostVisits = this->nodePool[child].visits;
+					result.bestMove = this->nodePool[child].column;
+				}
+			}
+
+			return result;
+		}
+
+		//Number of tree nodes taken from the pool by the last search
+		int getNodesInTree() const {
+			return std::min(this->nodesInUse.load(), this->nodePoolSize);
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef OPENINGBOOK
+#define OPENINGBOOK
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace controller {
+
+	//Computer moves for the first positions of a game, worked out ahead of time by deep searches. The book file is a header
+	//followed by the position hashes of the positions in increasing order and then the move for each of them, one byte each.
+	//The file is memory-mapped rather than read, so opening it costs the same however large it is, and pages are only read
+	//from disk when a lookup touches them. Windows builds read the whole file into memory instead. Numbers are stored in the
+	//byte order of the machine that built the book.
+	class OpeningBook {
+
+	private:
+
+		struct Header {
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t numberOfRows, numberOfColumns;
+			std::uint32_t searchDepth, numberOfPlies;
+			std::uint64_t numberOfEntries;
+		};
+
+		//Constants
+		const static std::uint32_t FORMAT_VERSION = 1;
+
+		void* mappedFile;
+		size_t mappedSize;
+
+#ifdef _WIN32
+		//Contents of the book file, kept in 64-bit words so that the position hashes after the header are aligned
+		std::vector<std::uint64_t> fileContents;
+#endif
+		const Header* header;
+		const std::uint64_t* positionKeys;
+		const std::uint8_t* moves;
+
+#ifdef _WIN32
+		//Read the whole book file into memory. Returns false if the file cannot be read or is empty.
+		bool mapFile(const std::string& fileName) {
+
+			std::ifstream bookFile(fileName.c_str(), std::ios::binary | std::ios::ate);
+			std::streamoff fileSize = bookFile ? static_cast<std::streamoff>(bookFile.tellg()) : 0;
+			if (fileSize <= 0) {
+				return false;
+			}
+
+			this->fileContents.assign((static_cast<size_t>(fileSize) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t), 0);
+			bookFile.seekg(0);
+			if (!bookFile.read(reinterpret_cast<char*>(this->fileContents.data()), fileSize)) {
+				this->fileContents.clear();
+				return false;
+			}
+
+			this->mappedFile = this->fileContents.data();
+			this->mappedSize = static_cast<size_t>(fileSize);
+			return true;
+		}
+
+		void unmapFile() {
+			std::vector<std::uint64_t>().swap(this->fileContents);
+		}
+#else
+		//Map the book file into memory. Returns false if the file cannot be mapped or is empty.
+		bool mapFile(const std::string& fileName) {
+
+			int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+			if (fileDescriptor < 0) {
+				return false;
+			}
+
+			struct stat fileStatus;
+			if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0) {
+				::close(fileDescriptor);
+				return false;
+			}
+
+			void* mappedFile = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			::close(fileDescriptor);
+			if (mappedFile == MAP_FAILED) {
+				return false;
+			}
+
+			this->mappedFile = mappedFile;
+			this->mappedSize = static_cast<size_t>(fileStatus.st_size);
+			return true;
+		}
+
+		void unmapFile() {
+			munmap(this->mappedFile, this->mappedSize);
+		}
+#endif
+
+		static void setMagic(Header& header) {
+			std::memcpy(header.magic, "C4BK", sizeof(header.magic));
+		}
+
+		//Check that the mapped file is a book for boards of the required size and is as long as the header says
+		bool isValidBook(int numberOfRows, int numberOfColumns) const {
+
+			if (this->mappedSize < sizeof(Header)) {
+				return false;
+			}
+
+			Header expectedHeader;
+			setMagic(expectedHeader);
+			const Header* header = static_cast<const Header*>(this->mappedFile);
+			return std::memcmp(header->magic, expectedHeader.magic, sizeof(header->magic)) == 0 && header->version == FORMAT_VERSION &&
+				header->numberOfRows == static_cast<std::uint32_t>(numberOfRows) && header->numberOfColumns == static_cast<std::uint32_t>(numberOfColumns) &&
+				header->numberOfEntries <= (this->mappedSize - sizeof(Header)) / (sizeof(std::uint64_t) + sizeof(std::uint8_t)) &&
+				this->mappedSize == sizeof(Header) + header->numberOfEntries * (sizeof(std::uint64_t) + sizeof(std::uint8_t));
+		}
+
+	public:
+
+		//Default constructor will create a book with no moves
+		OpeningBook() {
+			this->mappedFile = nullptr;
+			this->mappedSize = 0;
+			this->header = nullptr;
+			this->positionKeys = nullptr;
+			this->moves = nullptr;
+		}
+
+		OpeningBook(const OpeningBook&) = delete;
+		OpeningBook& operator=(const OpeningBook&) = delete;
+
+		~OpeningBook() {
+			close();
+		}
+
+		//Map a book file for boards of the required size. Returns false, and leaves the book empty, if the file cannot be
+		//mapped or is not a book for boards of this size.
+		bool open(const std::string& fileName, int numberOfRows, int numberOfColumns) {
+
+			close();
+			if (!mapFile(fileName)) {
+				return false;
+			}
+
+			if (!isValidBook(numberOfRows, numberOfColumns)) {
+				close();
+				return false;
+			}
+
+			this->header = static_cast<const Header*>(this->mappedFile);
+			this->positionKeys = reinterpret_cast<const std::uint64_t*>(this->header + 1);
+			this->moves = reinterpret_cast<const std::uint8_t*>(this->positionKeys + this->header->numberOfEntries);
+			return true;
+		}
+
+		//Unmap the book file
+		void close() {
+
+			if (this->mappedFile != nullptr) {
+				unmapFile();
+			}
+
+			this->mappedFile = nullptr;
+			this->mappedSize = 0;
+			this->header = nullptr;
+			this->positionKeys = nullptr;
+			this->moves = nullptr;
+		}
+
+		bool isOpen() const {
+			return this->header != nullptr;
+		}
+
+		//Find the move for a position by binary search. Returns false if the position is not in the book.
+		bool lookup(std::uint64_t positionKey, int& move) const {
+
+			if (!isOpen()) {
+				return false;
+			}
+
+			const std::uint64_t* lastPositionKey = this->positionKeys + this->header->numberOfEntries;
+			const std::uint64_t* foundPositionKey = std::lower_bound(this->positionKeys, lastPositionKey, positionKey);
+			if (foundPositionKey == lastPositionKey || *foundPositionKey != positionKey) {
+				return false;
+			}
+
+			move = this->moves[foundPositionKey - this->positionKeys];
+			return true;
+		}
+
+		//Depth of the searches the moves in the book came from
+		int getSearchDepth() const {
+			return isOpen() ? static_cast<int>(this->header->searchDepth) : 0;
+		}
+
+		//Number of coins on the board in the last positions in the book
+		int getNumberOfPlies() const {
+			return isOpen() ? static_cast<int>(this->header->numberOfPlies) : 0;
+		}
+
+		size_t getNumberOfEntries() const {
+			return isOpen() ? static_cast<size_t>(this->header->numberOfEntries) : 0;
+		}
+
+		//Write a book file from position hashes and the moves to play in them. Returns false if the file cannot be written.
+		static bool write(const std::string& fileName, int numberOfRows, int numberOfColumns, int searchDepth, int numberOfPlies,
+			std::vector<std::pair<std::uint64_t, int> > entries) {
+
+			std::sort(entries.begin(), entries.end());
+			entries.erase(std::unique(entries.begin(), entries.end(), [](const std::pair<std::uint64_t, int>& first, const std::pair<std::uint64_t, int>& second) {
+				return first.first == second.first;
+			}), entries.end());
+
+			Header header;
+			setMagic(header);
+			header.version = FORMAT_VERSION;
+			header.numberOfRows = numberOfRows;
+			header.numberOfColumns = numberOfColumns;
+			header.searchDepth = searchDepth;
+			header.numberOfPlies = numberOfPlies;
+			header.numberOfEntries = entries.size();
+
+			std::vector<std::uint64_t> positionKeys;
+			std::vector<std::uint8_t> moves;
+			for (const std::pair<std::uint64_t, int>& entry : entries) {
+				positionKeys.push_back(entry.first);
+				moves.push_back(static_cast<std::uint8_t>(entry.second));
+			}
+
+			std::ofstream bookFile(fileName.c_str(), std::ios::binary | std::ios::trunc);
+			bookFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			bookFile.write(reinterpret_cast<const char*>(positionKeys.data()), positionKeys.size() * sizeof(std::uint64_t));
+			bookFile.write(reinterpret_cast<const char*>(moves.data()), moves.size() * sizeof(std::uint8_t));
+			return static_cast<bool>(bookFile);
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef POSITIONANALYSIS
+#define POSITIONANALYSIS
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "ConnectFourGame.hpp"
+#include "EndgameSolver.hpp"
+#include "GameBoard.hpp"
+
+#include <chrono>
+#include <climits>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace controller {
+
+	//Scores of every column for a batch of positions, worked out many positions at a time across all cores. Positions are
+	//given as the columns played from the empty board, numbered from 1, one digit per coin, as in the standard Connect Four
+	//benchmark sets. A line may end with the expected score of the position for the player to move, which is compared with
+	//the score found.
+	class PositionAnalysis {
+
+	public:
+
+		//Settings of the engine. Exact scores come from the endgame solver on the scale of the benchmark sets: a win with the
+		//player's last coin scores 1, a win with the coin before it 2 and so on, with losses the same negated and draws 0.
+		//Heuristic scores come from the search to the difficulty level.
+		struct Settings {
+			int numberOfRows, numberOfColumns, difficultyLevel;
+			bool solveExactly;
+
+			Settings() : numberOfRows(6), numberOfColumns(7), difficultyLevel(6), solveExactly(false) {
+			}
+		};
+
+		//Position read from a line of a positions file
+		struct Position {
+			std::string moves;
+			bool hasExpectedScore;
+			int expectedScore;
+		};
+
+		//Scores of a position for the player to move. Full columns score INT_MIN. Positions that are not valid, because a
+		//column is not on the board or is full or the game is already over, have no scores.
+		struct Analysis {
+			Position position;
+			bool isValid;
+			std::vector<int> moveScores;
+			int bestMove, score;
+		};
+
+		struct Results {
+			std::vector<Analysis> analyses;
+			int validPositions, positionsWithExpectedScore, exactScores, exactOutcomes;
+			long long nodesSearched;
+			double wallTimeInSeconds;
+
+			Results() : validPositions(0), positionsWithExpectedScore(0), exactScores(0), exactOutcomes(0), nodesSearched(0), wallTimeInSeconds(0) {
+			}
+
+			double getPositionsPerSecond() const {
+				return this->wallTimeInSeconds > 0 ? this->validPositions / this->wallTimeInSeconds : 0;
+			}
+		};
+
+	private:
+
+		Settings settings;
+
+		//Engines for one thread, set up the first time the thread needs them and reused from position to position
+		struct Engines {
+			std::unique_ptr<ConnectFourGame> connectFourGame;
+			std::unique_ptr<EndgameSolver> endgameSolver;
+		};
+
+		//Set up the board for a position with the player to move as the computer. Returns false if the position is not valid.
+		bool setUpBoard(const std::string& moves, model::GameBoard& gameBoard) const {
+
+			int numberOfMoves = static_cast<int>(moves.size());
+			for (int moveCounter = 0; moveCounter < numberOfMoves; ++moveCounter) {
+
+				int column = moves[moveCounter] - '1';
+				if (column < 0 || column >= this->settings.numberOfColumns || !gameBoard.isValidPlay(column)) {
+					return false;
+				}
+
+				//The player who played the last coin is the user
+				gameBoard.dropCoin(column, (numberOfMoves - moveCounter) % 2 == 1);
+				if (gameBoard.isWinningPlay(column)) {
+					return false;
+				}
+			}
+
+			return numberOfMoves < this->settings.numberOfRows * this->settings.numberOfColumns;
+		}
+
+		//Score of a solution on the scale of the benchmark sets. The winner's coins left after the winning one are the empty
+		//slots after it, halved since the players take turns.
+		static int getBenchmarkScore(const EndgameSolver::Solution& solution, int numberOfEmptySlots) {
+
+			int score = (numberOfEmptySlots + 2 - solution.movesToEnd) / 2;
+			if (solution.outcome == EndgameSolver::Outcome::win) {
+				return score;
+			}
+			else if (solution.outcome == EndgameSolver::Outcome::loss) {
+				return -score;
+			}
+			else {
+				return 0;
+			}
+		}
+
+		//Exact scores of every column by solving the position after each move for the opponent
+		std::vector<int> solveMoves(EndgameSolver& endgameSolver, model::GameBoard& gameBoard, long long& nodesSearched) const {
+
+			std::vector<int> moveScores(this->settings.numberOfColumns, INT_MIN);
+			for (int column = 0; column < this->settings.numberOfColumns; ++column) {
+
+				if (!gameBoard.isValidPlay(column)) {
+					continue;
+				}
+
+				gameBoard.dropCoin(column, false);
+				if (gameBoard.isWinningPlay(column)) {
+					moveScores[column] = (gameBoard.getNumberOfEmptySlots() + 2) / 2;
+				}
+				else if (gameBoard.getNumberOfEmptySlots() == 0) {
+					moveScores[column] = 0;
+				}
+				else {
+					moveScores[column] = -getBenchmarkScore(endgameSolver.solve(gameBoard, true), gameBoard.getNumberOfEmptySlots());
+					nodesSearched += endgameSolver.getNodesSearched();
+				}
+				gameBoard.removeCoin(column);
+			}
+
+			return moveScores;
+		}
+
+		static int getOutcome(int score) {
+			return score > 0 ? 1 : (score < 0 ? -1 : 0);
+		}
+
+		//Score every column of one position with the engines of the current thread
+		void analyzePosition(Analysis& analysis, Engines& engines, long long& nodesSearched) const {
+
+			analysis.bestMove = -1;
+			analysis.score = INT_MIN;
+			model::GameBoard gameBoard(this->settings.numberOfRows, this->settings.numberOfColumns);
+			analysis.isValid = setUpBoard(analysis.position.moves, gameBoard);
+			if (!analysis.isValid) {
+				return;
+			}
+
+			if (this->settings.solveExactly) {
+				if (!engines.endgameSolver) {
+					engines.endgameSolver.reset(new EndgameSolver(this->settings.numberOfRows, this->settings.numberOfColumns));
+				}
+				analysis.moveScores = solveMoves(*engines.endgameSolver, gameBoard, nodesSearched);
+			}
+			else {
+				if (!engines.connectFourGame) {
+					engines.connectFourGame.reset(new ConnectFourGame(this->settings.numberOfRows, this->settings.numberOfColumns));
+					engines.connectFourGame->setgameDifficultyLevel(this->settings.difficultyLevel);
+					engines.connectFourGame->setComputationModeToParallel(false);
+				}
+				std::vector<ConnectFourGame::ColumnAnalysis> columnAnalyses = engines.connectFourGame->analyze(gameBoard);
+				for (const ConnectFourGame::ColumnAnalysis& columnAnalysis : columnAnalyses) {
+					analysis.moveScores.push_back(columnAnalysis.score);
+				}
+				nodesSearched += engines.connectFourGame->getNodesSearchedForLastMove();
+			}
+
+			//Ties go to the lowest column, as in the search for the computer's move
+			for (int column = 0; column < this->settings.numberOfColumns; ++column) {
+				if (analysis.moveScores[column] > analysis.score) {
+					analysis.score = analysis.moveScores[column];
+					analysis.bestMove = column;
+				}
+			}
+		}
+
+		static void writeScore(std::ostream& output, int score, const char* missingScore) {
+
+			if (score == INT_MIN) {
+				output << missingScore;
+			}
+			else {
+				output << score;
+			}
+		}
+
+	public:
+
+		PositionAnalysis(const Settings& settings) {
+			this->settings = settings;
+		}
+
+		//Read a position from a line of a positions file: the moves, then optionally the expected score after a space.
+		//Returns false for a blank line.
+		static bool readPosition(const std::string& line, Position& position) {
+
+			std::istringstream lineStream(line);
+			if (!(lineStream >> position.moves)) {
+				return false;
+			}
+
+			position.hasExpectedScore = static_cast<bool>(lineStream >> position.expectedScore);
+			if (!position.hasExpectedScore) {
+				position.expectedScore = 0;
+			}
+			return true;
+		}
+
+		//Score every position, as many at a time as there are threads, and count how many expected scores and outcomes were found
+		Results analyze(const std::vector<Position>& positions) const {
+
+			Results results;
+			results.analyses.resize(positions.size());
+			tbb::enumerable_thread_specific<Engines> threadEngines;
+			tbb::enumerable_thread_specific<long long> threadNodesSearched(0);
+
+			std::chrono::steady_clock::time_point analysisStart = std::chrono::steady_clock::now();
+			tbb::parallel_for(size_t(0), positions.size(), [&](size_t positionIndex) {
+
+				//A thread waiting on the tasks of a search must not start another position with the same engines
+				tbb::this_task_arena::isolate([&] {
+					Analysis& analysis = results.analyses[positionIndex];
+					analysis.position = positions[positionIndex];
+					analyzePosition(analysis, threadEngines.local(), threadNodesSearched.local());
+				});
+			});
+			results.wallTimeInSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - analysisStart).count();
+
+			for (long long nodesSearched : threadNodesSearched) {
+				results.nodesSearched += nodesSearched;
+			}
+			for (const Analysis& analysis : results.analyses) {
+				if (analysis.isValid) {
+					++results.validPositions;
+					if (analysis.position.hasExpectedScore) {
+						++results.positionsWithExpectedScore;
+						results.exactScores += analysis.score == analysis.position.expectedScore ? 1 : 0;
+						results.exactOutcomes += getOutcome(analysis.score) == getOutcome(analysis.position.expectedScore) ? 1 : 0;
+					}
+				}
+			}
+
+			return results;
+		}
+
+		//Write one line per position with the moves, the score of each column, the best column, numbered from 1, the score
+		//of the position and the expected score. Full columns and values that are not known are left empty.
+		void writeCsv(std::ostream& output, const Results& results) const {
+
+			output << "moves";
+			for (int column = 1; column <= this->settings.numberOfColumns; ++column) {
+				output << ",column" << column;
+			}
+			output << ",bestMove,score,expectedScore\n";
+
+			for (const Analysis& analysis : results.analyses) {
+
+				output << analysis.position.moves;
+				for (int column = 0; column < this->settings.numberOfColumns; ++column) {
+					output << ",";
+					writeScore(output, analysis.isValid ? analysis.moveScores[column] : INT_MIN, "");
+				}
+				output << ",";
+				if (analysis.isValid) {
+					output << analysis.bestMove + 1;
+				}
+				output << ",";
+				writeScore(output, analysis.score, "");
+				output << ",";
+				if (analysis.position.hasExpectedScore) {
+					output << analysis.position.expectedScore;
+				}
+				output << "\n";
+			}
+		}
+
+		//Write the same values as an array with one object per position. Values that are not known are null.
+		void writeJson(std::ostream& output, const Results& results) const {
+
+			output << "[\n";
+			for (size_t analysisCounter = 0; analysisCounter < results.analyses.size(); ++analysisCounter) {
+
+				const Analysis& analysis = results.analyses[analysisCounter];
+				output << "  {\"moves\": \"" << analysis.position.moves << "\", \"valid\": " << (analysis.isValid ? "true" : "false") << ", \"scores\": [";
+				for (int column = 0; analysis.isValid && column < this->settings.numberOfColumns; ++column) {
+					output << (column > 0 ? ", " : "");
+					writeScore(output, analysis.moveScores[column], "null");
+				}
+				output << "], \"bestMove\": ";
+				if (analysis.isValid) {
+					output << analysis.bestMove + 1;
+				}
+				else {
+					output << "null";
+				}
+				output << ", \"score\": ";
+				writeScore(output, analysis.score, "null");
+				output << ", \"expectedScore\": ";
+				if (analysis.position.hasExpectedScore) {
+					output << analysis.position.expectedScore;
+				}
+				else {
+					output << "null";
+				}
+				output << "}" << (analysisCounter + 1 < results.analyses.size() ? "," : "") << "\n";
+			}
+			output << "]\n";
+		}
+
+	};
+
+}
+
+#endif
@@ -41,8 +41,8 @@ void showGameBoard(const std::vector<GameSlot>& gameBoardVector, int numberOfRow
 
 int main() {
 
-	//Create a connect four game with default parameters
-	controller::ConnectFourGame connectFourGame{};
+	//Create a connect four game with default parameters on the standard board
+	controller::StandardConnectFourGame connectFourGame{};
 
 	//Set difficulty level
 	int difficultyLevel;
@@ -55,6 +55,12 @@ int main() {
 		std::cout << std::endl << "Difficulty level set to default value" << std::endl;
 	}
 
+	//Think about the computer's next move while waiting for the user
+	connectFourGame.setPondering(true);
+
+	//Play the first moves from the opening book if one has been built with BuildOpeningBook
+	connectFourGame.loadOpeningBook("openingbook.bin");
+
 	//std::string computationsInParallel;
 	//std::cout << "Do you want to run parallel computations? ";
 	//std::cin >> computationsInParallel;
@@ -62,7 +68,7 @@ int main() {
 	//	connectFourGame.setComputationModeToParallel(false);
 	//}
 
-	model::GameBoard gameBoard;
+	model::StandardGameBoard gameBoard;
 
 	while (true) {
 
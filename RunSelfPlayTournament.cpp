@@ -0,0 +1,73 @@
+#include "SelfPlayTournament.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+//Read a setting given as name=value, e.g. games=1000 or level1=4. Returns false if the argument is not for this setting.
+bool readSetting(const std::string& argument, const std::string& name, int& value) {
+
+	if (argument.compare(0, name.size() + 1, name + "=") != 0) {
+		return false;
+	}
+
+	value = std::atoi(argument.c_str() + name.size() + 1);
+	return true;
+}
+
+//Play games between two engine settings with no user and report throughput, results and move times:
+//RunSelfPlayTournament [games=N] [openings=N] [seed=N] [level1=N] [parallel1=0|1] [budget1=ms] [mcts1=0|1] [window1=0|1|2] [level2=N] [parallel2=0|1] [budget2=ms] [mcts2=0|1] [window2=0|1|2]
+//Windows are 0 for the full window, 1 for aspiration windows and 2 for MTD(f).
+int main(int argc, char* argv[]) {
+
+	controller::SelfPlayTournament::PlayerSettings playerSettings[2];
+	int numberOfGames = 100, randomOpeningPlies = 2, seed = 1;
+
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex) {
+
+		std::string argument = argv[argumentIndex];
+		int parallelMode, monteCarloTreeSearch, searchWindow;
+		bool isKnownSetting = readSetting(argument, "games", numberOfGames) || readSetting(argument, "openings", randomOpeningPlies) ||
+			readSetting(argument, "seed", seed);
+
+		for (int player = 0; player < 2 && !isKnownSetting; ++player) {
+			std::string playerNumber = std::to_string(player + 1);
+			isKnownSetting = readSetting(argument, "level" + playerNumber, playerSettings[player].difficultyLevel) ||
+				readSetting(argument, "budget" + playerNumber, playerSettings[player].moveTimeBudgetInMilliseconds);
+			if (!isKnownSetting && readSetting(argument, "parallel" + playerNumber, parallelMode)) {
+				playerSettings[player].parallelMode = parallelMode != 0;
+				isKnownSetting = true;
+			}
+			if (!isKnownSetting && readSetting(argument, "mcts" + playerNumber, monteCarloTreeSearch)) {
+				playerSettings[player].searchEngine = monteCarloTreeSearch != 0 ? controller::SearchEngine::monteCarloTreeSearch : controller::SearchEngine::minimax;
+				isKnownSetting = true;
+			}
+			if (!isKnownSetting && readSetting(argument, "window" + playerNumber, searchWindow) && searchWindow >= 0 && searchWindow <= 2) {
+				playerSettings[player].searchWindow = static_cast<controller::SearchWindow>(searchWindow);
+				isKnownSetting = true;
+			}
+		}
+
+		if (!isKnownSetting) {
+			std::cout << "Usage: " << argv[0] << " [games=N] [openings=N] [seed=N] [level1=N] [parallel1=0|1] [budget1=ms] [mcts1=0|1] [window1=0|1|2] [level2=N] [parallel2=0|1] [budget2=ms] [mcts2=0|1] [window2=0|1|2]" << std::endl;
+			return 1;
+		}
+	}
+
+	controller::SelfPlayTournament tournament(playerSettings[0], playerSettings[1]);
+	tournament.setNumberOfGames(numberOfGames);
+	tournament.setRandomOpeningPlies(randomOpeningPlies);
+	tournament.setSeed(seed);
+
+	controller::SelfPlayTournament::Results results = tournament.play();
+
+	std::cout << "Games: " << results.gamesPlayed << " in " << results.wallTimeInSeconds << " s, " << results.getGamesPerSecond() << " games/s" << std::endl;
+	std::cout << "Nodes: " << results.nodesSearched << ", " << results.getNodesPerSecond() << " nodes/s" << std::endl;
+	if (results.gamesPlayed > 0) {
+		std::cout << "Player 1 wins: " << 100.0 * results.playerOneWins / results.gamesPlayed << "%, draws: " << 100.0 * results.draws / results.gamesPlayed <<
+			"%, player 2 wins: " << 100.0 * results.playerTwoWins / results.gamesPlayed << "%" << std::endl;
+	}
+	std::cout << "Move time over " << results.movesPlayed << " moves: p50 " << results.getMoveLatencyPercentile(50) << " ms, p90 " <<
+		results.getMoveLatencyPercentile(90) << " ms, p99 " << results.getMoveLatencyPercentile(99) << " ms, max " << results.getMoveLatencyPercentile(100) << " ms" << std::endl;
+	return 0;
+}
@@ -0,0 +1,210 @@
+#ifndef SELFPLAYTOURNAMENT
+#define SELFPLAYTOURNAMENT
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "ConnectFourGame.hpp"
+#include "GameBoard.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace controller {
+
+	//Games between two engine settings on the standard board with no user, played many at a time across all cores. Both
+	//players are computer engines. Each engine sees the board with its own coins as computer coins, so it plays either colour.
+	class SelfPlayTournament {
+
+	public:
+
+		//Settings of one player
+		struct PlayerSettings {
+			int difficultyLevel;
+			bool parallelMode;
+			int moveTimeBudgetInMilliseconds;
+			SearchEngine searchEngine;
+			SearchWindow searchWindow;
+
+			PlayerSettings() : difficultyLevel(2), parallelMode(false), moveTimeBudgetInMilliseconds(0), searchEngine(SearchEngine::minimax),
+				searchWindow(SearchWindow::aspiration) {
+			}
+		};
+
+		//Results of a tournament. Wins are counted for the players in the order they were given, whichever colour they played.
+		struct Results {
+			int gamesPlayed, playerOneWins, playerTwoWins, draws;
+			long long movesPlayed, nodesSearched;
+			double wallTimeInSeconds;
+			std::vector<double> moveLatenciesInMilliseconds;
+
+			Results() : gamesPlayed(0), playerOneWins(0), playerTwoWins(0), draws(0), movesPlayed(0), nodesSearched(0), wallTimeInSeconds(0) {
+			}
+
+			double getGamesPerSecond() const {
+				return this->wallTimeInSeconds > 0 ? this->gamesPlayed / this->wallTimeInSeconds : 0;
+			}
+
+			double getNodesPerSecond() const {
+				return this->wallTimeInSeconds > 0 ? this->nodesSearched / this->wallTimeInSeconds : 0;
+			}
+
+			//Time to find a move that this percentage of moves were at or below, by the nearest rank
+			double getMoveLatencyPercentile(double percentile) const {
+
+				if (this->moveLatenciesInMilliseconds.empty()) {
+					return 0;
+				}
+
+				std::vector<double> sortedLatencies(this->moveLatenciesInMilliseconds);
+				std::sort(sortedLatencies.begin(), sortedLatencies.end());
+				size_t rank = static_cast<size_t>(std::ceil(percentile / 100 * sortedLatencies.size()));
+				return sortedLatencies[std::min(sortedLatencies.size() - 1, rank > 0 ? rank - 1 : 0)];
+			}
+		};
+
+	private:
+
+		//Constants for default values
+		const static int DEFAULT_NUMBER_OF_GAMES = 100;
+		const static int DEFAULT_RANDOM_OPENING_PLIES = 2;
+		const static int NUMBER_OF_PLAYERS = 2;
+
+		PlayerSettings playerSettings[NUMBER_OF_PLAYERS];
+		int numberOfGames, randomOpeningPlies;
+		unsigned int seed;
+
+		//Engines for both players, one set for each thread so that they are reused from game to game. Their search state is
+		//cleared before each game, so a game's result does not depend on which games the thread played before it.
+		struct Engines {
+			std::unique_ptr<StandardConnectFourGame> players[NUMBER_OF_PLAYERS];
+		};
+
+		//Set up an engine with the settings of a player the first time a thread needs it
+		StandardConnectFourGame& getEngine(Engines& engines, int player) const {
+
+			std::unique_ptr<StandardConnectFourGame>& engine = engines.players[player];
+			if (!engine) {
+				engine.reset(new StandardConnectFourGame());
+				engine->setgameDifficultyLevel(this->playerSettings[player].difficultyLevel);
+				engine->setComputationModeToParallel(this->playerSettings[player].parallelMode);
+				engine->setMoveTimeBudget(this->playerSettings[player].moveTimeBudgetInMilliseconds);
+				engine->setSearchEngine(this->playerSettings[player].searchEngine);
+				engine->setSearchWindow(this->playerSettings[player].searchWindow);
+			}
+
+			return *engine;
+		}
+
+		//Play one game and add its result to the results. Player one moves first in even numbered games. The opening moves are
+		//random so that the games differ, and are the same for the same seed and game number.
+		void playGame(int gameNumber, Engines& engines, Results& results) const {
+
+			int playerToMove = gameNumber % 2;
+			std::mt19937 random(this->seed + gameNumber);
+
+			//Boards as each player sees them, with the player's own coins as computer coins
+			model::StandardGameBoard playerBoards[NUMBER_OF_PLAYERS];
+			int numberOfSlots = playerBoards[0].getNumberOfRows() * playerBoards[0].getNumberOfColumns();
+			for (int player = 0; player < NUMBER_OF_PLAYERS; ++player) {
+				getEngine(engines, player).clearSearchState();
+			}
+
+			for (int coinsPlayed = 0; coinsPlayed < numberOfSlots; ++coinsPlayed) {
+
+				int columnToPlay;
+				if (coinsPlayed < this->randomOpeningPlies) {
+					do {
+						columnToPlay = random() % playerBoards[0].getNumberOfColumns();
+					} while (!playerBoards[0].isValidPlay(columnToPlay));
+				}
+				else {
+					StandardConnectFourGame& engine = getEngine(engines, playerToMove);
+					std::chrono::steady_clock::time_point moveStart = std::chrono::steady_clock::now();
+					columnToPlay = engine.searchComputerMove(playerBoards[playerToMove]);
+					results.moveLatenciesInMilliseconds.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - moveStart).count());
+					results.nodesSearched += engine.getNodesSearchedForLastMove();
+					++results.movesPlayed;
+				}
+
+				playerBoards[playerToMove].dropCoin(columnToPlay, false);
+				playerBoards[1 - playerToMove].dropCoin(columnToPlay, true);
+				if (playerBoards[playerToMove].isWinningPlay(columnToPlay)) {
+					++(playerToMove == 0 ? results.playerOneWins : results.playerTwoWins);
+					++results.gamesPlayed;
+					return;
+				}
+
+				playerToMove = 1 - playerToMove;
+			}
+
+			++results.draws;
+			++results.gamesPlayed;
+		}
+
+	public:
+
+		//Constructor with the settings of the two players
+		SelfPlayTournament(const PlayerSettings& playerOne, const PlayerSettings& playerTwo) {
+
+			this->playerSettings[0] = playerOne;
+			this->playerSettings[1] = playerTwo;
+			this->numberOfGames = DEFAULT_NUMBER_OF_GAMES;
+			this->randomOpeningPlies = DEFAULT_RANDOM_OPENING_PLIES;
+			this->seed = 1;
+		}
+
+		void setNumberOfGames(int numberOfGames) {
+			this->numberOfGames = numberOfGames;
+		}
+
+		//Number of random coins played at the start of every game before the engines take over
+		void setRandomOpeningPlies(int randomOpeningPlies) {
+			this->randomOpeningPlies = randomOpeningPlies;
+		}
+
+		void setSeed(unsigned int seed) {
+			this->seed = seed;
+		}
+
+		//Play all the games, as many at a time as there are threads, and merge the results of every thread at the end
+		Results play() const {
+
+			tbb::enumerable_thread_specific<Engines> threadEngines;
+			tbb::enumerable_thread_specific<Results> threadResults;
+
+			std::chrono::steady_clock::time_point tournamentStart = std::chrono::steady_clock::now();
+			tbb::parallel_for(0, this->numberOfGames, [&](int gameNumber) {
+
+				//A thread waiting for the tasks of a parallel search must not start another game with the same engines
+				tbb::this_task_arena::isolate([&] {
+					playGame(gameNumber, threadEngines.local(), threadResults.local());
+				});
+			});
+
+			Results results;
+			results.wallTimeInSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tournamentStart).count();
+			for (const Results& threadResult : threadResults) {
+				results.gamesPlayed += threadResult.gamesPlayed;
+				results.playerOneWins += threadResult.playerOneWins;
+				results.playerTwoWins += threadResult.playerTwoWins;
+				results.draws += threadResult.draws;
+				results.movesPlayed += threadResult.movesPlayed;
+				results.nodesSearched += threadResult.nodesSearched;
+				results.moveLatenciesInMilliseconds.insert(results.moveLatenciesInMilliseconds.end(), threadResult.moveLatenciesInMilliseconds.begin(),
+					threadResult.moveLatenciesInMilliseconds.end());
+			}
+
+			return results;
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef TRANSPOSITIONTABLE
+#define TRANSPOSITIONTABLE
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace controller {
+
+	//Fixed size table of search results keyed by position hash. Entries can be read and written from several
+	//threads at once without locks. Each slot stores the key xor'ed with the data, so a slot torn by two
+	//concurrent writes fails the key check and is treated as a miss.
+	class TranspositionTable {
+
+	public:
+
+		enum class BoundType { exact, lowerBound, upperBound };
+
+		struct Entry {
+			int depth;
+			BoundType boundType;
+			int score;
+			int bestMove;
+		};
+
+	private:
+
+		struct Slot {
+			std::atomic<std::uint64_t> checkedKey;
+			std::atomic<std::uint64_t> data;
+		};
+
+		//Constants
+		const static int DEFAULT_SIZE_IN_BITS = 20;
+		const static int DEPTH_BITS = 8;
+		const static int BOUND_TYPE_BITS = 2;
+		const static int BEST_MOVE_BITS = 8;
+
+		std::vector<Slot> slots;
+		std::uint64_t indexMask;
+
+		//Pack an entry into one 64 bit word. The best move is offset by one so that no move is stored as zero.
+		static std::uint64_t packEntry(const Entry& entry) {
+
+			std::uint64_t data = static_cast<std::uint32_t>(entry.score);
+			data = (data << DEPTH_BITS) | static_cast<std::uint64_t>(entry.depth);
+			data = (data << BOUND_TYPE_BITS) | static_cast<std::uint64_t>(entry.boundType);
+			data = (data << BEST_MOVE_BITS) | static_cast<std::uint64_t>(entry.bestMove + 1);
+			return data;
+		}
+
+		static Entry unpackEntry(std::uint64_t data) {
+
+			Entry entry;
+			entry.bestMove = static_cast<int>(data & ((1 << BEST_MOVE_BITS) - 1)) - 1;
+			data >>= BEST_MOVE_BITS;
+			entry.boundType = static_cast<BoundType>(data & ((1 << BOUND_TYPE_BITS) - 1));
+			data >>= BOUND_TYPE_BITS;
+			entry.depth = static_cast<int>(data & ((1 << DEPTH_BITS) - 1));
+			data >>= DEPTH_BITS;
+			entry.score = static_cast<int>(static_cast<std::uint32_t>(data));
+			return entry;
+		}
+
+	public:
+
+		//Default constructor will create a table with about a million entries
+		TranspositionTable() : slots(std::uint64_t(1) << DEFAULT_SIZE_IN_BITS) {
+			this->indexMask = (std::uint64_t(1) << DEFAULT_SIZE_IN_BITS) - 1;
+			clear();
+		}
+
+		//Constructor with the number of entries as a power of two
+		explicit TranspositionTable(int sizeInBits) : slots(std::uint64_t(1) << sizeInBits) {
+			this->indexMask = (std::uint64_t(1) << sizeInBits) - 1;
+			clear();
+		}
+
+		//Remove all entries
+		void clear() {
+			for (Slot& slot : this->slots) {
+				slot.checkedKey.store(0, std::memory_order_relaxed);
+				slot.data.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		//Look up the entry for a position. Returns false if the position has not been stored.
+		bool lookup(std::uint64_t key, Entry& entry) const {
+
+			const Slot& slot = this->slots[key & this->indexMask];
+			std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+			if (data == 0 || (slot.checkedKey.load(std::memory_order_relaxed) ^ data) != key) {
+				return false;
+			}
+
+			entry = unpackEntry(data);
+			return true;
+		}
+
+		//Store the entry for a position. A deeper result for the same position is not overwritten by a shallower one.
+		void store(std::uint64_t key, const Entry& entry) {
+
+			Slot& slot = this->slots[key & this->indexMask];
+			std::uint64_t storedData = slot.data.load(std::memory_order_relaxed);
+			if (storedData != 0 && (slot.checkedKey.load(std::memory_order_relaxed) ^ storedData) == key && unpackEntry(storedData).depth > entry.depth) {
+				return;
+			}
+
+			std::uint64_t data = packEntry(entry);
+			slot.checkedKey.store(key ^ data, std::memory_order_relaxed);
+			slot.data.store(data, std::memory_order_relaxed);
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef WINDOWTABLE
+#define WINDOWTABLE
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace model {
+
+	//Every four-in-a-row window on a board of one shape, and for every cell the windows that contain it.
+	//Tables are built once per number of rows and columns and shared by all boards of that shape.
+	class WindowTable {
+
+	public:
+
+		//Constants
+		const static int COINS_IN_A_ROW_TO_WIN = 4;
+		const static int WINDOW_DIRECTIONS = 4;
+
+	private:
+
+		int numberOfWindows;
+
+		//Board indices of the cells in each window, four per window
+		std::vector<int> windowCells;
+
+		//Windows containing each cell grouped by direction. The windows for a cell and direction start at
+		//the offset for that pair and end at the offset for the next one.
+		std::vector<int> cellWindows;
+		std::vector<int> cellWindowOffsets;
+
+		//Row and column steps from one cell of a window to the next. Windows run horizontally, vertically, up to the right and down to the right.
+		static int getRowStep(int direction) {
+			const int rowSteps[] = { 0, 1, -1, 1 };
+			return rowSteps[direction];
+		}
+
+		static int getColumnStep(int direction) {
+			const int columnSteps[] = { 1, 0, 1, 1 };
+			return columnSteps[direction];
+		}
+
+		//List the windows in each direction and then index them by the cells they contain
+		WindowTable(int numberOfRows, int numberOfColumns) {
+
+			std::vector<std::vector<int> > windowsForCellAndDirection(numberOfRows * numberOfColumns * WINDOW_DIRECTIONS);
+			for (int direction = 0; direction < WINDOW_DIRECTIONS; ++direction) {
+
+				int rowStep = getRowStep(direction), columnStep = getColumnStep(direction);
+				for (int startRow = 0; startRow < numberOfRows; ++startRow) {
+					for (int startColumn = 0; startColumn < numberOfColumns; ++startColumn) {
+
+						int endRow = startRow + (COINS_IN_A_ROW_TO_WIN - 1) * rowStep, endColumn = startColumn + (COINS_IN_A_ROW_TO_WIN - 1) * columnStep;
+						if (endRow < 0 || endRow >= numberOfRows || endColumn >= numberOfColumns) {
+							continue;
+						}
+
+						int windowIndex = static_cast<int>(this->windowCells.size()) / COINS_IN_A_ROW_TO_WIN;
+						for (int cellInWindow = 0; cellInWindow < COINS_IN_A_ROW_TO_WIN; ++cellInWindow) {
+							int boardIndex = (startRow + cellInWindow * rowStep) * numberOfColumns + startColumn + cellInWindow * columnStep;
+							this->windowCells.push_back(boardIndex);
+							windowsForCellAndDirection[boardIndex * WINDOW_DIRECTIONS + direction].push_back(windowIndex);
+						}
+					}
+				}
+			}
+
+			this->numberOfWindows = static_cast<int>(this->windowCells.size()) / COINS_IN_A_ROW_TO_WIN;
+			this->cellWindowOffsets.push_back(0);
+			for (const std::vector<int>& windows : windowsForCellAndDirection) {
+				this->cellWindows.insert(this->cellWindows.end(), windows.begin(), windows.end());
+				this->cellWindowOffsets.push_back(static_cast<int>(this->cellWindows.size()));
+			}
+		}
+
+	public:
+
+		//Table for a board shape. It is built by the first caller and kept for the life of the program.
+		static const WindowTable* getWindowTable(int numberOfRows, int numberOfColumns) {
+
+			static std::mutex windowTablesMutex;
+			static std::map<std::pair<int, int>, std::unique_ptr<WindowTable> > windowTables;
+
+			std::lock_guard<std::mutex> lock(windowTablesMutex);
+			std::unique_ptr<WindowTable>& windowTable = windowTables[std::make_pair(numberOfRows, numberOfColumns)];
+			if (!windowTable) {
+				windowTable.reset(new WindowTable(numberOfRows, numberOfColumns));
+			}
+
+			return windowTable.get();
+		}
+
+		int getNumberOfWindows() const {
+			return this->numberOfWindows;
+		}
+
+		//Board indices of the four cells in a window
+		const int* getWindowCells(int windowIndex) const {
+			return &this->windowCells[windowIndex * COINS_IN_A_ROW_TO_WIN];
+		}
+
+		//Windows of one direction that contain the cell. Directions are numbered horizontal, vertical, positive slope and negative slope.
+		const int* getWindowsContainingCell(int boardIndex, int direction, int& numberOfWindows) const {
+
+			int offsetIndex = boardIndex * WINDOW_DIRECTIONS + direction;
+			numberOfWindows = this->cellWindowOffsets[offsetIndex + 1] - this->cellWindowOffsets[offsetIndex];
+			return this->cellWindows.data() + this->cellWindowOffsets[offsetIndex];
+		}
+
+		//Windows in every direction that contain the cell
+		const int* getWindowsContainingCell(int boardIndex, int& numberOfWindows) const {
+
+			int offsetIndex = boardIndex * WINDOW_DIRECTIONS;
+			numberOfWindows = this->cellWindowOffsets[offsetIndex + WINDOW_DIRECTIONS] - this->cellWindowOffsets[offsetIndex];
+			return this->cellWindows.data() + this->cellWindowOffsets[offsetIndex];
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,773 @@
+#include <catch.hpp>
+
+#include "ConnectFourGame.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Compile every member of the games on the common board sizes
+template class controller::BasicConnectFourGame<6, 7>;
+template class controller::BasicConnectFourGame<7, 8>;
+template class controller::BasicConnectFourGame<8, 9>;
+
+namespace
+{
+// Columns played by the user in the scripted games below
+const int SCRIPTED_USER_MOVES[] = {3, 3, 2, 4, 1, 5, 0, 6, 2, 2, 4, 4, 3, 1, 5, 0, 6, 6, 1, 0, 5};
+
+// Play the scripted user moves and record the board after every computer reply
+template <typename Game>
+std::vector<std::vector<GameSlot> > playScriptedGame(
+  Game& connectFourGame, long long& nodesSearched)
+{
+  std::vector<std::vector<GameSlot> > boardsAfterEachMove;
+  nodesSearched = 0;
+  for (int column : SCRIPTED_USER_MOVES)
+  {
+    if (connectFourGame.isGameOver()) break;
+    if (!connectFourGame.getGameBoard().isValidPlay(column)) continue;
+    connectFourGame.dropCoin(column);
+    nodesSearched += connectFourGame.getNodesSearchedForLastMove();
+    boardsAfterEachMove.push_back(
+      connectFourGame.getGameBoard().getGameBoardVector());
+  }
+  return boardsAfterEachMove;
+}
+
+// Positions of the scripted game with the computer to move, with both players
+// following the scripted moves so that every search starts from the same
+// position whatever the settings
+template <typename GameBoard>
+std::vector<GameBoard> getScriptedPositions()
+{
+  std::vector<GameBoard> positions;
+  GameBoard gameBoard;
+  bool isUserCoin = true;
+  for (int column : SCRIPTED_USER_MOVES)
+  {
+    if (!gameBoard.isValidPlay(column)) continue;
+    gameBoard.dropCoin(column, isUserCoin);
+    if (gameBoard.isWinningPlay(column)) break;
+    isUserCoin = !isUserCoin;
+    if (!isUserCoin) positions.push_back(gameBoard);
+  }
+  return positions;
+}
+
+// Search a computer move for every scripted position. Returns the computer
+// moves found.
+template <typename Game>
+std::vector<int> searchScriptedPositions(Game& connectFourGame,
+                                         long long& nodesSearched)
+{
+  std::vector<int> computerMoves;
+  nodesSearched = 0;
+  for (const typename Game::GameBoard& position :
+       getScriptedPositions<typename Game::GameBoard>())
+  {
+    computerMoves.push_back(connectFourGame.searchComputerMove(position));
+    nodesSearched += connectFourGame.getNodesSearchedForLastMove();
+  }
+  return computerMoves;
+}
+
+bool haveSameCoins(const std::vector<std::vector<GameSlot> >& first,
+                   const std::vector<std::vector<GameSlot> >& second)
+{
+  if (first.size() != second.size()) return false;
+  for (size_t move = 0; move < first.size(); ++move)
+  {
+    for (size_t slot = 0; slot < first[move].size(); ++slot)
+    {
+      if (first[move][slot].hasUserCoin() != second[move][slot].hasUserCoin() ||
+          first[move][slot].hasComputerCoin() !=
+            second[move][slot].hasComputerCoin())
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+TEST_CASE("alphaBetaMatchesFullSearch", "[connectFourGame]")
+{
+  for (int difficultyLevel = 1; difficultyLevel <= 5; ++difficultyLevel)
+  {
+    for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+    {
+      controller::ConnectFourGame fullSearchGame;
+      fullSearchGame.setgameDifficultyLevel(difficultyLevel);
+      fullSearchGame.setComputationModeToParallel(parallelMode == 1);
+      fullSearchGame.setAlphaBetaPruning(false);
+
+      controller::ConnectFourGame prunedSearchGame;
+      prunedSearchGame.setgameDifficultyLevel(difficultyLevel);
+      prunedSearchGame.setComputationModeToParallel(parallelMode == 1);
+
+      long long fullSearchNodes, prunedSearchNodes;
+      std::vector<std::vector<GameSlot> > fullSearchBoards =
+        playScriptedGame(fullSearchGame, fullSearchNodes);
+      std::vector<std::vector<GameSlot> > prunedSearchBoards =
+        playScriptedGame(prunedSearchGame, prunedSearchNodes);
+
+      REQUIRE(haveSameCoins(fullSearchBoards, prunedSearchBoards));
+      if (difficultyLevel >= 3)
+      {
+        REQUIRE(prunedSearchNodes < fullSearchNodes);
+      }
+    }
+  }
+}
+
+TEST_CASE("transpositionTableKeepsSearchResult", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame uncachedGame;
+    uncachedGame.setgameDifficultyLevel(6);
+    uncachedGame.setComputationModeToParallel(parallelMode == 1);
+    uncachedGame.setTranspositionTable(false);
+
+    controller::ConnectFourGame cachedGame;
+    cachedGame.setgameDifficultyLevel(6);
+    cachedGame.setComputationModeToParallel(parallelMode == 1);
+
+    long long uncachedNodes, cachedNodes;
+    std::vector<std::vector<GameSlot> > uncachedBoards =
+      playScriptedGame(uncachedGame, uncachedNodes);
+    std::vector<std::vector<GameSlot> > cachedBoards =
+      playScriptedGame(cachedGame, cachedNodes);
+
+    REQUIRE(haveSameCoins(uncachedBoards, cachedBoards));
+    REQUIRE(cachedNodes < uncachedNodes);
+  }
+}
+
+TEST_CASE("searchPlaysMovesInPlace", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame connectFourGame;
+    connectFourGame.setgameDifficultyLevel(5);
+    connectFourGame.setComputationModeToParallel(parallelMode == 1);
+
+    for (int column : SCRIPTED_USER_MOVES)
+    {
+      if (connectFourGame.isGameOver()) break;
+      if (!connectFourGame.getGameBoard().isValidPlay(column)) continue;
+      connectFourGame.dropCoin(column);
+      REQUIRE(connectFourGame.getBoardAllocationsForLastMove() == 0);
+    }
+  }
+}
+
+TEST_CASE("fixedSizeBoardMatchesRuntimeSize", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame runtimeSizeGame;
+    runtimeSizeGame.setgameDifficultyLevel(5);
+    runtimeSizeGame.setComputationModeToParallel(parallelMode == 1);
+
+    controller::StandardConnectFourGame fixedSizeGame;
+    fixedSizeGame.setgameDifficultyLevel(5);
+    fixedSizeGame.setComputationModeToParallel(parallelMode == 1);
+
+    long long runtimeSizeNodes, fixedSizeNodes;
+    std::vector<std::vector<GameSlot> > runtimeSizeBoards =
+      playScriptedGame(runtimeSizeGame, runtimeSizeNodes);
+    std::vector<std::vector<GameSlot> > fixedSizeBoards =
+      playScriptedGame(fixedSizeGame, fixedSizeNodes);
+
+    REQUIRE(haveSameCoins(runtimeSizeBoards, fixedSizeBoards));
+  }
+
+  REQUIRE_THROWS_AS(controller::StandardConnectFourGame(7, 8), const std::logic_error&);
+}
+
+TEST_CASE("parallelSearchMatchesSerialSearch", "[connectFourGame]")
+{
+  controller::ConnectFourGame serialGame;
+  serialGame.setgameDifficultyLevel(6);
+  serialGame.setComputationModeToParallel(false);
+
+  long long serialNodes;
+  std::vector<std::vector<GameSlot> > serialBoards =
+    playScriptedGame(serialGame, serialNodes);
+
+  for (int depthCutoff = 1; depthCutoff <= 7; depthCutoff += 3)
+  {
+    controller::ConnectFourGame parallelGame;
+    parallelGame.setgameDifficultyLevel(6);
+    parallelGame.setParallelSearchDepthCutoff(depthCutoff);
+
+    long long parallelNodes;
+    std::vector<std::vector<GameSlot> > parallelBoards =
+      playScriptedGame(parallelGame, parallelNodes);
+
+    REQUIRE(haveSameCoins(serialBoards, parallelBoards));
+  }
+}
+
+TEST_CASE("moveOrderingReducesNodesSearched", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame unorderedGame;
+    unorderedGame.setgameDifficultyLevel(6);
+    unorderedGame.setComputationModeToParallel(parallelMode == 1);
+    unorderedGame.setCenterFirstMoveOrdering(false);
+    unorderedGame.setKillerMoves(false);
+    unorderedGame.setHistoryHeuristic(false);
+
+    controller::ConnectFourGame orderedGame;
+    orderedGame.setgameDifficultyLevel(6);
+    orderedGame.setComputationModeToParallel(parallelMode == 1);
+
+    long long unorderedNodes, orderedNodes;
+    std::vector<std::vector<GameSlot> > unorderedBoards =
+      playScriptedGame(unorderedGame, unorderedNodes);
+    std::vector<std::vector<GameSlot> > orderedBoards =
+      playScriptedGame(orderedGame, orderedNodes);
+
+    REQUIRE(haveSameCoins(unorderedBoards, orderedBoards));
+    REQUIRE(orderedNodes < unorderedNodes);
+  }
+
+  controller::ConnectFourGame connectFourGame;
+  connectFourGame.setgameDifficultyLevel(6);
+  connectFourGame.dropCoin(3);
+  REQUIRE(connectFourGame.getCutoffRateForLastMove(0) == 0);
+  REQUIRE(connectFourGame.getCutoffRateForLastMove(1) > 0);
+  REQUIRE(connectFourGame.getCutoffRateForLastMove(1) <= 1);
+}
+
+TEST_CASE("timeBudgetDeepensUntilTimeRunsOut", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame budgetedGame;
+    budgetedGame.setComputationModeToParallel(parallelMode == 1);
+    budgetedGame.setMoveTimeBudget(50);
+
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    budgetedGame.dropCoin(3);
+    long long elapsedMilliseconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    REQUIRE(budgetedGame.getGameBoard().getNumberOfCoins() == 2);
+    REQUIRE(budgetedGame.getDepthReachedForLastMove() >= 1);
+    REQUIRE(elapsedMilliseconds < 1000);
+  }
+
+  // A small board is searched to the end well within the budget. The endgame
+  // solver is turned off so that the iterative deepening gets there.
+  controller::ConnectFourGame smallGame(4, 4);
+  smallGame.setEndgameSolverThreshold(0);
+  smallGame.setMoveTimeBudget(10000);
+  smallGame.dropCoin(0);
+  REQUIRE(smallGame.getDepthReachedForLastMove() == 15);
+
+  // With the solver on, the same board is solved to the end even at a
+  // difficulty level that searches two plies
+  controller::ConnectFourGame solvedGame(4, 4);
+  solvedGame.setgameDifficultyLevel(2);
+  solvedGame.dropCoin(0);
+  REQUIRE(solvedGame.getDepthReachedForLastMove() == 15);
+
+  // Without a budget the search stops at the difficulty level
+  controller::ConnectFourGame fixedDepthGame;
+  fixedDepthGame.setgameDifficultyLevel(4);
+  fixedDepthGame.dropCoin(3);
+  REQUIRE(fixedDepthGame.getDepthReachedForLastMove() == 4);
+}
+
+TEST_CASE("ponderingPlaysTheSameMovesSooner", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame ponderingGame;
+    ponderingGame.setgameDifficultyLevel(5);
+    ponderingGame.setComputationModeToParallel(parallelMode == 1);
+    ponderingGame.setPondering(true);
+
+    controller::ConnectFourGame referenceGame;
+    referenceGame.setgameDifficultyLevel(5);
+    referenceGame.setComputationModeToParallel(parallelMode == 1);
+
+    int ponderedMoves = 0;
+    for (int column : SCRIPTED_USER_MOVES)
+    {
+      if (referenceGame.isGameOver()) break;
+      if (!referenceGame.getGameBoard().isValidPlay(column)) continue;
+
+      // Give the computer the user's thinking time to ponder every reply
+      std::chrono::steady_clock::time_point giveUpTime =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (ponderingGame.isPondering() &&
+             std::chrono::steady_clock::now() < giveUpTime)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      referenceGame.dropCoin(column);
+      ponderingGame.dropCoin(column);
+      if (ponderingGame.wasLastMovePondered())
+      {
+        ++ponderedMoves;
+        REQUIRE(ponderingGame.getNodesSearchedForLastMove() == 0);
+      }
+
+      std::vector<std::vector<GameSlot> > referenceBoard(
+        1, referenceGame.getGameBoard().getGameBoardVector());
+      std::vector<std::vector<GameSlot> > ponderingBoard(
+        1, ponderingGame.getGameBoard().getGameBoardVector());
+      REQUIRE(haveSameCoins(referenceBoard, ponderingBoard));
+    }
+
+    REQUIRE(ponderedMoves > 0);
+  }
+
+  // A user move cancels pondering that is still running
+  controller::ConnectFourGame cancelledGame;
+  cancelledGame.setgameDifficultyLevel(9);
+  cancelledGame.setPondering(true);
+  cancelledGame.dropCoin(3);
+  cancelledGame.dropCoin(3);
+  cancelledGame.setPondering(false);
+  REQUIRE_FALSE(cancelledGame.isPondering());
+}
+
+TEST_CASE("requestedComputerMovesMatchDropCoin", "[connectFourGame]")
+{
+  tbb::task_arena sharedArena(2, 0);
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame asyncGame;
+    asyncGame.setgameDifficultyLevel(5);
+    asyncGame.setComputationModeToParallel(parallelMode == 1);
+    asyncGame.setPondering(parallelMode == 1);
+    if (parallelMode == 1) asyncGame.setSearchArena(sharedArena);
+
+    controller::ConnectFourGame referenceGame;
+    referenceGame.setgameDifficultyLevel(5);
+    referenceGame.setComputationModeToParallel(parallelMode == 1);
+
+    for (int column : SCRIPTED_USER_MOVES)
+    {
+      if (referenceGame.isGameOver()) break;
+      if (!referenceGame.getGameBoard().isValidPlay(column)) continue;
+
+      referenceGame.dropCoin(column);
+      REQUIRE(asyncGame.playUserMove(column));
+      if (asyncGame.isGameOver()) break;
+
+      // The user cannot move again until the computer has replied
+      REQUIRE_FALSE(asyncGame.playUserMove(column == 0 ? 1 : 0));
+
+      std::atomic<int> calledBackColumn(-2);
+      std::shared_future<int> computerMove = asyncGame.requestComputerMove(
+        [&calledBackColumn](int column) { calledBackColumn = column; });
+      int columnPlayed = computerMove.get();
+      REQUIRE(columnPlayed >= 0);
+
+      controller::ConnectFourGame::SearchProgress searchProgress =
+        asyncGame.getComputerMoveProgress();
+      REQUIRE_FALSE(searchProgress.moveIsPending);
+      REQUIRE(searchProgress.depthReached ==
+              referenceGame.getDepthReachedForLastMove());
+
+      std::vector<std::vector<GameSlot> > referenceBoard(
+        1, referenceGame.getGameBoard().getGameBoardVector());
+      std::vector<std::vector<GameSlot> > asyncBoard(
+        1, asyncGame.getGameBoard().getGameBoardVector());
+      REQUIRE(haveSameCoins(referenceBoard, asyncBoard));
+
+      // The callback runs right after the future is ready
+      while (calledBackColumn == -2)
+      {
+        std::this_thread::yield();
+      }
+      REQUIRE(calledBackColumn == columnPlayed);
+    }
+  }
+}
+
+TEST_CASE("requestedComputerMoveCanBeCancelled", "[connectFourGame]")
+{
+  controller::ConnectFourGame connectFourGame;
+  connectFourGame.setgameDifficultyLevel(14);
+  REQUIRE(connectFourGame.requestComputerMove().get() == -1);
+
+  REQUIRE(connectFourGame.playUserMove(3));
+  std::shared_future<int> computerMove = connectFourGame.requestComputerMove();
+  connectFourGame.cancelComputerMove();
+  REQUIRE(computerMove.get() == -1);
+  REQUIRE_FALSE(connectFourGame.isComputerMovePending());
+
+  REQUIRE(connectFourGame.getGameBoard().getNumberOfCoins() == 1);
+
+  // The move can be asked for again once the search is cancelled
+  connectFourGame.setgameDifficultyLevel(3);
+  REQUIRE(connectFourGame.requestComputerMove().get() >= 0);
+  REQUIRE(connectFourGame.getComputerMoveProgress().nodesSearched > 0);
+}
+
+TEST_CASE("searchStatsAddUpTheWorkOfEveryThread", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame connectFourGame;
+    connectFourGame.setgameDifficultyLevel(6);
+    connectFourGame.setComputationModeToParallel(parallelMode == 1);
+    connectFourGame.dropCoin(3);
+
+    const controller::ConnectFourGame::SearchStats& searchStats =
+      connectFourGame.getSearchStatsForLastMove();
+    REQUIRE(searchStats.nodesSearched ==
+            connectFourGame.getNodesSearchedForLastMove());
+    REQUIRE(searchStats.evaluationCalls > 0);
+    REQUIRE(searchStats.evaluationCalls <= searchStats.nodesSearched);
+    REQUIRE(searchStats.cutoffs > 0);
+    REQUIRE(searchStats.maximumDepthReached == 6);
+    REQUIRE(searchStats.wallTimeInMilliseconds > 0);
+    REQUIRE((searchStats.tasksSpawned > 0) == (parallelMode == 1));
+
+    long long nodesSearchedByThreads = 0;
+    for (long long nodesSearched : searchStats.nodesSearchedPerThread)
+      nodesSearchedByThreads += nodesSearched;
+    REQUIRE(nodesSearchedByThreads == searchStats.nodesSearched);
+  }
+}
+
+TEST_CASE("symmetryReductionKeepsMovesAndSavesNodes", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame fullGame;
+    fullGame.setgameDifficultyLevel(6);
+    fullGame.setComputationModeToParallel(parallelMode == 1);
+    fullGame.setSymmetryReduction(false);
+
+    controller::ConnectFourGame reducedGame;
+    reducedGame.setgameDifficultyLevel(6);
+    reducedGame.setComputationModeToParallel(parallelMode == 1);
+
+    long long fullNodes, reducedNodes;
+    std::vector<std::vector<GameSlot> > fullBoards =
+      playScriptedGame(fullGame, fullNodes);
+    std::vector<std::vector<GameSlot> > reducedBoards =
+      playScriptedGame(reducedGame, reducedNodes);
+
+    // Parallel node counts depend on how the threads are scheduled
+    REQUIRE(haveSameCoins(fullBoards, reducedBoards));
+    if (parallelMode == 0)
+    {
+      REQUIRE(reducedNodes < fullNodes);
+    }
+  }
+
+  // The empty board is its own mirror image, so only half of it is searched
+  controller::ConnectFourGame::GameBoard emptyBoard;
+  controller::ConnectFourGame fullGame, reducedGame;
+  fullGame.setgameDifficultyLevel(8);
+  reducedGame.setgameDifficultyLevel(8);
+  fullGame.setSymmetryReduction(false);
+  REQUIRE(reducedGame.searchComputerMove(emptyBoard) ==
+          fullGame.searchComputerMove(emptyBoard));
+  double nodesRatio =
+    static_cast<double>(reducedGame.getNodesSearchedForLastMove()) /
+    fullGame.getNodesSearchedForLastMove();
+  REQUIRE(nodesRatio < 0.67);
+}
+
+TEST_CASE("threatDetectionPlaysForcedMovesWithoutSearching", "[connectFourGame]")
+{
+  controller::ConnectFourGame::GameBoard gameBoard;
+  controller::ConnectFourGame connectFourGame;
+  connectFourGame.setgameDifficultyLevel(6);
+
+  // The user has three in a row on the bottom with only one open end
+  gameBoard.dropCoin(0, false);
+  for (int column = 1; column <= 3; ++column)
+  {
+    gameBoard.dropCoin(column, true);
+  }
+  gameBoard.dropCoin(6, false);
+  REQUIRE(connectFourGame.searchComputerMove(gameBoard) == 4);
+  REQUIRE(connectFourGame.getNodesSearchedForLastMove() == 0);
+  REQUIRE(connectFourGame.getDepthReachedForLastMove() == 2);
+
+  // With three in a column of its own the computer wins first
+  gameBoard.dropCoin(5, true);
+  gameBoard.dropCoin(6, false);
+  gameBoard.dropCoin(5, true);
+  gameBoard.dropCoin(6, false);
+  REQUIRE(connectFourGame.searchComputerMove(gameBoard) == 6);
+  REQUIRE(connectFourGame.getNodesSearchedForLastMove() == 0);
+  REQUIRE(connectFourGame.getDepthReachedForLastMove() == 1);
+
+  // Rows from the top with the user's coins as U and the computer's as C. The
+  // user has three in a row on the third row, so a computer coin in column 1
+  // or 5 lets the user win in the slot above it and column 6 is the only move
+  // left. Few slots are empty, so the endgame solver is turned off to get to
+  // the threats.
+  const char* const trappedRows[] = {"U.CUC..", "U.CUC..", "C.CCU..",
+                                     "U.UUU..", "C.CUC..", "UCCCUU."};
+  controller::ConnectFourGame::GameBoard trappedBoard;
+  for (int row = 5; row >= 0; --row)
+  {
+    for (int column = 0; column < 7; ++column)
+    {
+      if (trappedRows[row][column] != '.')
+      {
+        trappedBoard.dropCoin(column, trappedRows[row][column] == 'U');
+      }
+    }
+  }
+  REQUIRE(trappedBoard.givesOpponentWinAbove(1, false));
+  REQUIRE(trappedBoard.givesOpponentWinAbove(5, false));
+  connectFourGame.setEndgameSolverThreshold(0);
+  REQUIRE(connectFourGame.searchComputerMove(trappedBoard) == 6);
+  REQUIRE(connectFourGame.getNodesSearchedForLastMove() == 0);
+  REQUIRE(connectFourGame.getDepthReachedForLastMove() == 2);
+
+  controller::ConnectFourGame trappedSearchingGame;
+  trappedSearchingGame.setgameDifficultyLevel(6);
+  trappedSearchingGame.setThreatDetection(false);
+  trappedSearchingGame.setEndgameSolverThreshold(0);
+  REQUIRE(trappedSearchingGame.searchComputerMove(trappedBoard) == 6);
+  REQUIRE(trappedSearchingGame.getNodesSearchedForLastMove() > 0);
+
+  // Moves may differ where they score the same, e.g. winning at once instead
+  // of a few moves later, so both moves are scored by a full window search
+  controller::ConnectFourGame scoringGame;
+  scoringGame.setgameDifficultyLevel(6);
+  scoringGame.setComputationModeToParallel(false);
+  scoringGame.setThreatDetection(false);
+  const std::vector<controller::ConnectFourGame::GameBoard> positions =
+    getScriptedPositions<controller::ConnectFourGame::GameBoard>();
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame searchingGame;
+    searchingGame.setgameDifficultyLevel(6);
+    searchingGame.setComputationModeToParallel(parallelMode == 1);
+    searchingGame.setThreatDetection(false);
+
+    controller::ConnectFourGame detectingGame;
+    detectingGame.setgameDifficultyLevel(6);
+    detectingGame.setComputationModeToParallel(parallelMode == 1);
+
+    long long searchingNodes = 0, detectingNodes = 0;
+    for (const controller::ConnectFourGame::GameBoard& position : positions)
+    {
+      int searchingMove = searchingGame.searchComputerMove(position);
+      searchingNodes += searchingGame.getNodesSearchedForLastMove();
+      int detectingMove = detectingGame.searchComputerMove(position);
+      detectingNodes += detectingGame.getNodesSearchedForLastMove();
+
+      std::vector<controller::ConnectFourGame::ColumnAnalysis> columnAnalyses =
+        scoringGame.analyze(position);
+      REQUIRE(columnAnalyses[detectingMove].score ==
+              columnAnalyses[searchingMove].score);
+    }
+
+    // Parallel node counts depend on how the threads are scheduled
+    if (parallelMode == 0)
+    {
+      REQUIRE(detectingNodes < searchingNodes);
+    }
+  }
+}
+
+TEST_CASE("analyzeScoresEveryColumnInOneSearch", "[connectFourGame]")
+{
+  // The user has three in a row on the bottom with only one open end
+  controller::ConnectFourGame::GameBoard gameBoard;
+  gameBoard.dropCoin(0, false);
+  for (int column = 1; column <= 3; ++column)
+  {
+    gameBoard.dropCoin(column, true);
+  }
+  gameBoard.dropCoin(6, false);
+
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame fullSearchGame;
+    fullSearchGame.setgameDifficultyLevel(5);
+    fullSearchGame.setComputationModeToParallel(parallelMode == 1);
+    fullSearchGame.setAlphaBetaPruning(false);
+    fullSearchGame.setTranspositionTable(false);
+
+    controller::ConnectFourGame analyzingGame;
+    analyzingGame.setgameDifficultyLevel(5);
+    analyzingGame.setComputationModeToParallel(parallelMode == 1);
+
+    // Every column gets its exact score, not a bound
+    std::vector<controller::ConnectFourGame::ColumnAnalysis> fullSearchAnalyses =
+      fullSearchGame.analyze(gameBoard);
+    std::vector<controller::ConnectFourGame::ColumnAnalysis> columnAnalyses =
+      analyzingGame.analyze(gameBoard);
+    REQUIRE(columnAnalyses.size() == 7);
+    REQUIRE(analyzingGame.getDepthReachedForLastMove() == 5);
+
+    long long nodesForEveryColumn = 0;
+    int bestColumn = 0;
+    for (int column = 0; column < 7; ++column)
+    {
+      const controller::ConnectFourGame::ColumnAnalysis& columnAnalysis =
+        columnAnalyses[column];
+      REQUIRE(columnAnalysis.isValid);
+      REQUIRE(columnAnalysis.score == fullSearchAnalyses[column].score);
+      REQUIRE(columnAnalysis.nodesSearched > 0);
+      nodesForEveryColumn += columnAnalysis.nodesSearched;
+      if (columnAnalysis.score > columnAnalyses[bestColumn].score)
+      {
+        bestColumn = column;
+      }
+
+      // The principal variation is a line of valid moves from the column on
+      REQUIRE(columnAnalysis.principalVariation.size() >= 1);
+      REQUIRE(columnAnalysis.principalVariation.size() <= 5);
+      REQUIRE(columnAnalysis.principalVariation[0] == column);
+    }
+    REQUIRE(nodesForEveryColumn ==
+            analyzingGame.getNodesSearchedForLastMove());
+
+    // Only the block saves the game, and the user wins straight away after
+    // any other column
+    REQUIRE(bestColumn == 4);
+    REQUIRE(columnAnalyses[5].score == -1 * INT_MAX);
+    REQUIRE(columnAnalyses[5].principalVariation.size() == 2);
+    REQUIRE(columnAnalyses[5].principalVariation[1] == 4);
+  }
+
+  // Mirrored columns on a symmetric board share one search
+  controller::ConnectFourGame connectFourGame;
+  connectFourGame.setgameDifficultyLevel(4);
+  std::vector<controller::ConnectFourGame::ColumnAnalysis> columnAnalyses =
+    connectFourGame.analyze(controller::ConnectFourGame::GameBoard());
+  for (int column = 0; column < 3; ++column)
+  {
+    const controller::ConnectFourGame::ColumnAnalysis& mirroredAnalysis =
+      columnAnalyses[6 - column];
+    REQUIRE(mirroredAnalysis.score == columnAnalyses[column].score);
+    REQUIRE(mirroredAnalysis.nodesSearched == 0);
+    REQUIRE(mirroredAnalysis.principalVariation.size() ==
+            columnAnalyses[column].principalVariation.size());
+    REQUIRE(mirroredAnalysis.principalVariation[0] == 6 - column);
+  }
+}
+
+TEST_CASE("searchReuseCarriesWorkAcrossTurns", "[connectFourGame]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    std::vector<int> computerMoves[2];
+    long long nodesSearched[2];
+    for (int searchReuse = 0; searchReuse <= 1; ++searchReuse)
+    {
+      controller::ConnectFourGame connectFourGame;
+      connectFourGame.setgameDifficultyLevel(8);
+      connectFourGame.setComputationModeToParallel(parallelMode == 1);
+      connectFourGame.setSearchReuse(searchReuse == 1);
+      computerMoves[searchReuse] =
+        searchScriptedPositions(connectFourGame, nodesSearched[searchReuse]);
+    }
+
+    // Parallel node counts depend on how the threads are scheduled
+    REQUIRE(computerMoves[1] == computerMoves[0]);
+    if (parallelMode == 0)
+    {
+      REQUIRE(nodesSearched[1] < nodesSearched[0]);
+    }
+  }
+
+  // The principal variation starts with the computer's move and is a line of
+  // valid moves as long as the search looked ahead
+  controller::ConnectFourGame connectFourGame;
+  connectFourGame.setgameDifficultyLevel(6);
+  connectFourGame.dropCoin(3);
+  controller::ConnectFourGame::GameBoard gameBoard =
+    connectFourGame.getGameBoard();
+  const std::vector<int>& principalVariation =
+    connectFourGame.getPrincipalVariationForLastMove();
+  REQUIRE(principalVariation.size() >= 1);
+  REQUIRE(principalVariation.size() <= 6);
+
+  int computerMove = principalVariation[0];
+  REQUIRE(gameBoard.getGameSlot(gameBoard.getPlayedSlot(computerMove))
+            .hasComputerCoin());
+  gameBoard.removeCoin(computerMove);
+  bool isUserCoin = false;
+  for (int move : principalVariation)
+  {
+    REQUIRE(gameBoard.isValidPlay(move));
+    gameBoard.dropCoin(move, isUserCoin);
+    isUserCoin = !isUserCoin;
+  }
+}
+
+TEST_CASE("narrowSearchWindowsSaveNodes", "[connectFourGame]")
+{
+  const controller::SearchWindow searchWindows[] = {
+    controller::SearchWindow::full, controller::SearchWindow::aspiration,
+    controller::SearchWindow::mtdf};
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    std::vector<int> computerMoves[3];
+    long long nodesSearched[3];
+    for (int window = 0; window < 3; ++window)
+    {
+      controller::ConnectFourGame connectFourGame;
+      connectFourGame.setgameDifficultyLevel(8);
+      connectFourGame.setComputationModeToParallel(parallelMode == 1);
+      connectFourGame.setSearchWindow(searchWindows[window]);
+      computerMoves[window] =
+        searchScriptedPositions(connectFourGame, nodesSearched[window]);
+    }
+
+    // An aspiration window plays the moves of the full window, and both
+    // narrower windows search fewer nodes. Parallel node counts depend on how
+    // the threads are scheduled.
+    REQUIRE(computerMoves[1] == computerMoves[0]);
+    if (parallelMode == 0)
+    {
+      REQUIRE(nodesSearched[1] < nodesSearched[0]);
+      REQUIRE(nodesSearched[2] < nodesSearched[0]);
+    }
+  }
+
+  // Searching a position again takes the score of the last search as its
+  // guess. The aspiration window holds it, and MTD(f) needs a null window
+  // search on each side of it.
+  controller::ConnectFourGame::GameBoard gameBoard;
+  gameBoard.dropCoin(3, true);
+  const int rootSearchesWithGuess[] = {1, 1, 2};
+  for (int window = 0; window < 3; ++window)
+  {
+    controller::ConnectFourGame connectFourGame;
+    connectFourGame.setgameDifficultyLevel(8);
+    connectFourGame.setSearchWindow(searchWindows[window]);
+    connectFourGame.searchComputerMove(gameBoard);
+    REQUIRE(connectFourGame.getSearchStatsForLastMove().rootSearches == 1);
+    connectFourGame.searchComputerMove(gameBoard);
+    REQUIRE(connectFourGame.getSearchStatsForLastMove().rootSearches ==
+            rootSearchesWithGuess[window]);
+  }
+
+  // With a time budget each depth takes the score of the one before as its
+  // guess
+  controller::ConnectFourGame connectFourGame;
+  connectFourGame.setSearchWindow(controller::SearchWindow::mtdf);
+  connectFourGame.setMoveTimeBudget(50);
+  connectFourGame.dropCoin(3);
+  REQUIRE(connectFourGame.getDepthReachedForLastMove() > 1);
+  REQUIRE(connectFourGame.getSearchStatsForLastMove().rootSearches >
+          connectFourGame.getDepthReachedForLastMove());
+}
@@ -0,0 +1,222 @@
+#include <catch.hpp>
+
+#include "ConnectFourGame.hpp"
+#include "EndgameSolver.hpp"
+#include "GameBoard.hpp"
+
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+const int NUMBER_OF_SLOTS = 42;
+
+// Score of the position for the player to move by trying every line to the
+// end of the game. A win with the t-th coin scores NUMBER_OF_SLOTS + 1 - t.
+int getScoreByFullSearch(model::StandardGameBoard& gameBoard, bool isUserCoin,
+                         int coinsPlayed)
+{
+  if (coinsPlayed == NUMBER_OF_SLOTS) return 0;
+
+  int bestScore = -NUMBER_OF_SLOTS;
+  for (int column = 0; column < gameBoard.getNumberOfColumns(); ++column)
+  {
+    if (!gameBoard.isValidPlay(column)) continue;
+    gameBoard.dropCoin(column, isUserCoin);
+    int score = gameBoard.isWinningPlay(column)
+                  ? NUMBER_OF_SLOTS - coinsPlayed
+                  : -getScoreByFullSearch(gameBoard, !isUserCoin,
+                                          coinsPlayed + 1);
+    gameBoard.removeCoin(column);
+    bestScore = std::max(bestScore, score);
+  }
+  return bestScore;
+}
+
+int getScore(const controller::EndgameSolver::Solution& solution,
+             int coinsPlayed)
+{
+  int coinsAtEnd = coinsPlayed + solution.movesToEnd;
+  if (solution.outcome == controller::EndgameSolver::Outcome::win)
+    return NUMBER_OF_SLOTS + 1 - coinsAtEnd;
+  if (solution.outcome == controller::EndgameSolver::Outcome::loss)
+    return -(NUMBER_OF_SLOTS + 1 - coinsAtEnd);
+  return 0;
+}
+
+// Play random coins until only the required number of slots are empty.
+// Returns false if a player won on the way.
+bool playRandomOpening(model::StandardGameBoard& gameBoard,
+                       int numberOfEmptySlots, std::mt19937& random,
+                       bool& isUserCoin)
+{
+  isUserCoin = true;
+  for (int coinsPlayed = 0; coinsPlayed < NUMBER_OF_SLOTS - numberOfEmptySlots;)
+  {
+    int column = random() % gameBoard.getNumberOfColumns();
+    if (!gameBoard.isValidPlay(column)) continue;
+    gameBoard.dropCoin(column, isUserCoin);
+    if (gameBoard.isWinningPlay(column)) return false;
+    isUserCoin = !isUserCoin;
+    ++coinsPlayed;
+  }
+  return true;
+}
+
+// Random user move that wins if it can, otherwise blocks a computer win and
+// does not give the computer a win in the slot above
+int getCarefulUserMove(const model::StandardGameBoard& gameBoard,
+                       std::mt19937& random)
+{
+  std::vector<int> safeMoves;
+  for (int column = 0; column < gameBoard.getNumberOfColumns(); ++column)
+  {
+    if (!gameBoard.isValidPlay(column)) continue;
+
+    model::StandardGameBoard whatIfBoard = gameBoard;
+    whatIfBoard.dropCoin(column, true);
+    if (whatIfBoard.isWinningPlay(column)) return column;
+
+    whatIfBoard = gameBoard;
+    whatIfBoard.dropCoin(column, false);
+    if (whatIfBoard.isWinningPlay(column)) return column;
+
+    whatIfBoard = gameBoard;
+    whatIfBoard.dropCoin(column, true);
+    bool givesComputerWin = false;
+    if (whatIfBoard.isValidPlay(column))
+    {
+      whatIfBoard.dropCoin(column, false);
+      givesComputerWin = whatIfBoard.isWinningPlay(column);
+    }
+    if (!givesComputerWin) safeMoves.push_back(column);
+  }
+
+  if (safeMoves.empty())
+  {
+    for (int column = 0; column < gameBoard.getNumberOfColumns(); ++column)
+    {
+      if (gameBoard.isValidPlay(column)) return column;
+    }
+  }
+  return safeMoves[random() % safeMoves.size()];
+}
+}
+
+TEST_CASE("endgameSolverMatchesFullSearch", "[endgameSolver]")
+{
+  controller::EndgameSolver endgameSolver(6, 7);
+  std::mt19937 random(2014);
+
+  // Down to a single empty slot, where the only move is forced
+  for (int coinsPlayed = NUMBER_OF_SLOTS - 9; coinsPlayed < NUMBER_OF_SLOTS;
+       coinsPlayed += 4)
+  {
+    for (int positionCounter = 0; positionCounter < 50;)
+    {
+      model::StandardGameBoard gameBoard;
+      bool isUserCoin;
+      if (!playRandomOpening(gameBoard, NUMBER_OF_SLOTS - coinsPlayed, random,
+                             isUserCoin))
+        continue;
+      ++positionCounter;
+
+      controller::EndgameSolver::Solution solution =
+        endgameSolver.solve(gameBoard, isUserCoin);
+      int score = getScoreByFullSearch(gameBoard, isUserCoin, coinsPlayed);
+      REQUIRE(getScore(solution, coinsPlayed) == score);
+
+      // The best move keeps the score
+      REQUIRE(gameBoard.isValidPlay(solution.bestMove));
+      gameBoard.dropCoin(solution.bestMove, isUserCoin);
+      int scoreAfterBestMove =
+        gameBoard.isWinningPlay(solution.bestMove)
+          ? NUMBER_OF_SLOTS - coinsPlayed
+          : -getScoreByFullSearch(gameBoard, !isUserCoin, coinsPlayed + 1);
+      REQUIRE(scoreAfterBestMove == score);
+    }
+  }
+}
+
+TEST_CASE("endgameSolverFindsQuickestWin", "[endgameSolver]")
+{
+  controller::EndgameSolver endgameSolver(6, 7);
+
+  // Three user coins in the bottom row win with a coin on either side
+  model::StandardGameBoard gameBoard;
+  for (int column = 1; column <= 3; ++column)
+  {
+    gameBoard.dropCoin(column, true);
+    gameBoard.dropCoin(column, false);
+  }
+
+  controller::EndgameSolver::Solution solution =
+    endgameSolver.solve(gameBoard, true);
+  REQUIRE(solution.outcome == controller::EndgameSolver::Outcome::win);
+  REQUIRE(solution.movesToEnd == 1);
+  REQUIRE((solution.bestMove == 0 || solution.bestMove == 4));
+
+  // The computer can only block one side and loses with the next user coin
+  solution = endgameSolver.solve(gameBoard, false);
+  REQUIRE(solution.outcome == controller::EndgameSolver::Outcome::loss);
+  REQUIRE(solution.movesToEnd == 2);
+
+  REQUIRE_FALSE(controller::EndgameSolver::canSolve(8, 9));
+  REQUIRE_THROWS_AS(controller::EndgameSolver(8, 9), const std::logic_error&);
+}
+
+TEST_CASE("gameSolvesEndgamesBelowThreshold", "[endgameSolver]")
+{
+  controller::EndgameSolver endgameSolver(6, 7);
+  std::mt19937 random(7);
+  int solvedMoves = 0, searchedMoves = 0;
+
+  // Most games are over before the board is half full, so play until enough reach the endgame.
+  // Every other game has the solver turned off.
+  for (int gameCounter = 0;
+       gameCounter < 400 && (solvedMoves < 20 || searchedMoves < 20);
+       ++gameCounter)
+  {
+    bool solverEnabled = gameCounter % 2 == 0;
+    controller::StandardConnectFourGame connectFourGame;
+    connectFourGame.setgameDifficultyLevel(1);
+    if (!solverEnabled) connectFourGame.setEndgameSolverThreshold(0);
+
+    while (!connectFourGame.isGameOver())
+    {
+      int column = getCarefulUserMove(connectFourGame.getGameBoard(), random);
+
+      // Position the computer has to answer
+      model::StandardGameBoard gameBoard = connectFourGame.getGameBoard();
+      gameBoard.dropCoin(column, true);
+      int numberOfEmptySlots = gameBoard.getNumberOfEmptySlots();
+
+      connectFourGame.dropCoin(column);
+      if (gameBoard.isWinningPlay(column) || numberOfEmptySlots == 0) break;
+      if (numberOfEmptySlots >= 22) continue;
+
+      if (!solverEnabled)
+      {
+        ++searchedMoves;
+        REQUIRE(connectFourGame.getDepthReachedForLastMove() == 1);
+        continue;
+      }
+
+      ++solvedMoves;
+      int columnPlayed = -1;
+      const std::vector<GameSlot>& slotsAfterMove =
+        connectFourGame.getGameBoard().getGameBoardVector();
+      for (size_t slot = 0; slot < slotsAfterMove.size(); ++slot)
+      {
+        if (gameBoard.getGameBoardVector()[slot].isEmpty() &&
+            !slotsAfterMove[slot].isEmpty())
+          columnPlayed = gameBoard.getColumnNumber(static_cast<int>(slot));
+      }
+      REQUIRE(columnPlayed == endgameSolver.solve(gameBoard, false).bestMove);
+      REQUIRE(connectFourGame.getDepthReachedForLastMove() == numberOfEmptySlots);
+    }
+  }
+
+  REQUIRE(solvedMoves >= 20);
+  REQUIRE(searchedMoves >= 20);
+}
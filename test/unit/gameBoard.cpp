@@ -0,0 +1,167 @@
+#include <catch.hpp>
+
+#include "GameBoard.hpp"
+
+TEST_CASE("gameBoardTracksColumnHeights", "[gameBoard]")
+{
+  model::GameBoard gameBoard;
+
+  gameBoard.dropCoin(3, true);
+  gameBoard.dropCoin(3, false);
+
+  REQUIRE(gameBoard.getPlayedSlot(3) == gameBoard.getBoardIndex(4, 3));
+  REQUIRE(gameBoard.getAvailableSlot(3) == gameBoard.getBoardIndex(3, 3));
+  REQUIRE(gameBoard.getGameSlot(gameBoard.getBoardIndex(5, 3)).hasUserCoin());
+
+  for (int counter = 0; counter < 4; ++counter)
+  {
+    gameBoard.dropCoin(3, counter % 2 == 0);
+  }
+  REQUIRE_FALSE(gameBoard.isValidPlay(3));
+  REQUIRE_FALSE(gameBoard.isValidPlay(7));
+  REQUIRE(gameBoard.isValidPlay(0));
+  REQUIRE(gameBoard.getColumnHeight(3) == 6);
+  REQUIRE(gameBoard.getNumberOfCoins() == 6);
+  REQUIRE(gameBoard.getNumberOfEmptySlots() == 36);
+
+  // The coin count follows coins taken back and is full on a tall board
+  gameBoard.removeCoin(3);
+  REQUIRE(gameBoard.getColumnHeight(3) == 5);
+  REQUIRE(gameBoard.getNumberOfCoins() == 5);
+
+  model::GameBoard tallBoard(20, 2);
+  for (int row = 0; row < 20; ++row)
+  {
+    REQUIRE_FALSE(tallBoard.isFull());
+    tallBoard.dropCoin(0, row % 2 == 0);
+    tallBoard.dropCoin(1, row % 2 == 1);
+  }
+  REQUIRE(tallBoard.isFull());
+  REQUIRE(tallBoard.getNumberOfEmptySlots() == 0);
+}
+
+TEST_CASE("gameBoardDetectsFourInARow", "[gameBoard]")
+{
+  SECTION("horizontal")
+  {
+    model::GameBoard gameBoard;
+    for (int column = 1; column <= 4; ++column)
+    {
+      gameBoard.dropCoin(column, false);
+      REQUIRE(gameBoard.isWinningPlay(column) == (column == 4));
+    }
+    REQUIRE(gameBoard.isWinningPlay(4));
+  }
+
+  SECTION("vertical")
+  {
+    model::GameBoard gameBoard;
+    for (int counter = 0; counter < 3; ++counter)
+    {
+      gameBoard.dropCoin(6, true);
+    }
+    REQUIRE_FALSE(gameBoard.isWinningPlay(6));
+    gameBoard.dropCoin(6, true);
+    REQUIRE(gameBoard.isWinningPlay(6));
+  }
+
+  SECTION("diagonal on a board too large for the bitboard")
+  {
+    model::GameBoard gameBoard(9, 10);
+    for (int column = 0; column < 4; ++column)
+    {
+      for (int filler = 0; filler < column; ++filler)
+      {
+        gameBoard.dropCoin(column, false);
+      }
+      gameBoard.dropCoin(column, true);
+    }
+    REQUIRE(gameBoard.isWinningPlay(3));
+  }
+}
+
+TEST_CASE("gameBoardRebuiltFromVector", "[gameBoard]")
+{
+  model::GameBoard gameBoard;
+  gameBoard.dropCoin(2, true);
+  gameBoard.dropCoin(2, false);
+  gameBoard.dropCoin(5, true);
+
+  model::GameBoard copiedBoard(gameBoard.getGameBoardVector(), 6, 7);
+  REQUIRE(copiedBoard.getPlayedSlot(2) == gameBoard.getPlayedSlot(2));
+  REQUIRE(copiedBoard.getAvailableSlot(5) == gameBoard.getAvailableSlot(5));
+  REQUIRE(copiedBoard.getGameSlot(copiedBoard.getPlayedSlot(2)).hasComputerCoin());
+}
+
+TEST_CASE("gameBoardCountsCoinsInWindows", "[gameBoard]")
+{
+  model::GameBoard gameBoard;
+  int numberOfWindows;
+  const int* windowIndices;
+
+  // The bottom left slot is in one window going right and one going up to the right, but none going down to the right
+  gameBoard.dropCoin(0, true);
+  windowIndices = gameBoard.getWindowsContainingSlot(gameBoard.getPlayedSlot(0), 0, numberOfWindows);
+  REQUIRE(numberOfWindows == 1);
+  REQUIRE(gameBoard.getUserCoinsInWindow(windowIndices[0]) == 1);
+  windowIndices = gameBoard.getWindowsContainingSlot(gameBoard.getPlayedSlot(0), 2, numberOfWindows);
+  REQUIRE(numberOfWindows == 1);
+  windowIndices = gameBoard.getWindowsContainingSlot(gameBoard.getPlayedSlot(0), 3, numberOfWindows);
+  REQUIRE(numberOfWindows == 0);
+
+  // A middle slot on the bottom row is in four horizontal windows
+  gameBoard.dropCoin(3, false);
+  windowIndices = gameBoard.getWindowsContainingSlot(gameBoard.getPlayedSlot(3), 0, numberOfWindows);
+  REQUIRE(numberOfWindows == 4);
+  REQUIRE(gameBoard.getUserCoinsInWindow(windowIndices[0]) == 1);
+  REQUIRE(gameBoard.getComputerCoinsInWindow(windowIndices[0]) == 1);
+  REQUIRE(gameBoard.getUserCoinsInWindow(windowIndices[3]) == 0);
+
+  // Removing a coin takes it out of the counts again
+  gameBoard.removeCoin(3);
+  REQUIRE(gameBoard.getComputerCoinsInWindow(windowIndices[0]) == 0);
+  REQUIRE(gameBoard.getUserCoinsInWindow(windowIndices[0]) == 1);
+}
+
+TEST_CASE("windowTableSharedPerBoardShape", "[gameBoard]")
+{
+  const model::WindowTable* windowTable = model::WindowTable::getWindowTable(6, 7);
+  REQUIRE(windowTable == model::WindowTable::getWindowTable(6, 7));
+  REQUIRE(windowTable != model::WindowTable::getWindowTable(7, 6));
+
+  // 24 horizontal, 21 vertical and 12 in each diagonal direction
+  REQUIRE(windowTable->getNumberOfWindows() == 69);
+
+  // The centre of the bottom row is in four horizontal, one vertical and one window in each diagonal
+  int numberOfWindows;
+  windowTable->getWindowsContainingCell(5 * 7 + 3, numberOfWindows);
+  REQUIRE(numberOfWindows == 7);
+}
+
+TEST_CASE("gameBoardFindsWinningDrops", "[gameBoard]")
+{
+  model::GameBoard gameBoard;
+
+  // Three user coins in the bottom row win with a coin on either side
+  for (int column = 1; column <= 3; ++column)
+  {
+    gameBoard.dropCoin(column, true);
+  }
+  REQUIRE(gameBoard.isWinningDrop(0, true));
+  REQUIRE(gameBoard.isWinningDrop(4, true));
+  REQUIRE_FALSE(gameBoard.isWinningDrop(5, true));
+  REQUIRE_FALSE(gameBoard.isWinningDrop(4, false));
+
+  // With three user coins on the second row around an empty column, a computer coin there lets the user win on top of it
+  model::GameBoard secondRowBoard;
+  secondRowBoard.dropCoin(0, false);
+  secondRowBoard.dropCoin(1, false);
+  secondRowBoard.dropCoin(3, false);
+  for (int column : {0, 1, 3})
+  {
+    secondRowBoard.dropCoin(column, true);
+  }
+  REQUIRE(secondRowBoard.givesOpponentWinAbove(2, false));
+  REQUIRE_FALSE(secondRowBoard.isWinningDrop(2, true));
+  REQUIRE_FALSE(secondRowBoard.givesOpponentWinAbove(4, false));
+}
@@ -0,0 +1,115 @@
+#include <catch.hpp>
+
+#include "ConnectFourGame.hpp"
+#include "GameBoard.hpp"
+#include "MonteCarloTreeSearch.hpp"
+#include "SelfPlayTournament.hpp"
+
+#include <atomic>
+#include <chrono>
+
+TEST_CASE("monteCarloTreeSearchWinsAndBlocks", "[monteCarloTreeSearch]")
+{
+  std::atomic<bool> cancelled(false);
+  std::atomic<long long> playoutsCompleted(0);
+  std::chrono::steady_clock::time_point noDeadline =
+    std::chrono::steady_clock::time_point::max();
+
+  // The user has three in a row on the bottom and the computer has to block
+  model::GameBoard gameBoard;
+  for (int column = 0; column <= 2; ++column)
+  {
+    gameBoard.dropCoin(column, true);
+    gameBoard.dropCoin(column, false);
+  }
+  gameBoard.dropCoin(6, true);
+  controller::MonteCarloTreeSearch monteCarloTreeSearch(
+    gameBoard.getNumberOfRows(), gameBoard.getNumberOfColumns());
+  controller::MonteCarloTreeSearch::Result result =
+    monteCarloTreeSearch.search(gameBoard, false, 2000, noDeadline, false,
+                                cancelled, playoutsCompleted);
+  REQUIRE(result.bestMove == 3);
+  REQUIRE(result.playouts == 2000);
+  REQUIRE(result.maximumDepthReached > 1);
+  REQUIRE(monteCarloTreeSearch.getNodesInTree() > 1);
+
+  // A single thread plays out the same games every time
+  controller::MonteCarloTreeSearch::Result repeatedResult =
+    monteCarloTreeSearch.search(gameBoard, false, 2000, noDeadline, false,
+                                cancelled, playoutsCompleted);
+  REQUIRE(repeatedResult.bestMove == result.bestMove);
+  REQUIRE(repeatedResult.maximumDepthReached == result.maximumDepthReached);
+
+  // With three of its own in a column the computer wins instead
+  model::GameBoard winningBoard;
+  const int userColumns[] = {0, 1, 6};
+  for (int column : userColumns)
+  {
+    winningBoard.dropCoin(column, true);
+    winningBoard.dropCoin(5, false);
+  }
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    result = monteCarloTreeSearch.search(winningBoard, false, 2000, noDeadline,
+                                         parallelMode == 1, cancelled,
+                                         playoutsCompleted);
+    REQUIRE(result.bestMove == 5);
+    REQUIRE(result.playouts == 2000);
+  }
+
+  // A search that is cancelled stops straight away
+  cancelled = true;
+  result = monteCarloTreeSearch.search(winningBoard, false, 2000, noDeadline,
+                                       true, cancelled, playoutsCompleted);
+  REQUIRE(result.playouts == 0);
+}
+
+TEST_CASE("monteCarloTreeSearchPlaysLargeBoards", "[monteCarloTreeSearch]")
+{
+  for (int parallelMode = 0; parallelMode <= 1; ++parallelMode)
+  {
+    controller::ConnectFourGame connectFourGame(9, 10);
+    connectFourGame.setSearchEngine(
+      controller::SearchEngine::monteCarloTreeSearch);
+    connectFourGame.setgameDifficultyLevel(1);
+    connectFourGame.setComputationModeToParallel(parallelMode == 1);
+
+    connectFourGame.dropCoin(4);
+    const controller::ConnectFourGame::SearchStats& searchStats =
+      connectFourGame.getSearchStatsForLastMove();
+    REQUIRE(searchStats.nodesSearched == 5000);
+    REQUIRE(connectFourGame.getDepthReachedForLastMove() > 1);
+
+    long long nodesOnEveryThread = 0;
+    for (long long nodesSearched : searchStats.nodesSearchedPerThread)
+    {
+      nodesOnEveryThread += nodesSearched;
+    }
+    REQUIRE(nodesOnEveryThread == searchStats.nodesSearched);
+
+    // With a time budget the games are played out until it runs out
+    connectFourGame.setMoveTimeBudget(50);
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    connectFourGame.dropCoin(5);
+    long long elapsedMilliseconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    REQUIRE(connectFourGame.getNodesSearchedForLastMove() > 0);
+    REQUIRE(elapsedMilliseconds >= 50);
+    REQUIRE(elapsedMilliseconds < 1000);
+  }
+}
+
+TEST_CASE("monteCarloTreeSearchBeatsShallowSearch", "[monteCarloTreeSearch]")
+{
+  controller::SelfPlayTournament::PlayerSettings playoutPlayer, minimaxPlayer;
+  playoutPlayer.difficultyLevel = 1;
+  playoutPlayer.searchEngine = controller::SearchEngine::monteCarloTreeSearch;
+  minimaxPlayer.difficultyLevel = 2;
+
+  controller::SelfPlayTournament tournament(playoutPlayer, minimaxPlayer);
+  tournament.setNumberOfGames(4);
+  controller::SelfPlayTournament::Results results = tournament.play();
+  REQUIRE(results.playerOneWins > results.playerTwoWins);
+}
@@ -0,0 +1,83 @@
+#include <catch.hpp>
+
+#include "ConnectFourGame.hpp"
+#include "GameBoard.hpp"
+#include "OpeningBook.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const char* const BOOK_FILE_NAME = "openingBookTest.bin";
+}
+
+TEST_CASE("openingBookLooksUpWrittenMoves", "[openingBook]")
+{
+  std::vector<std::pair<std::uint64_t, int> > bookEntries;
+  for (int positionCounter = 1; positionCounter <= 1000; ++positionCounter)
+  {
+    bookEntries.push_back(
+      std::make_pair(positionCounter * 0x9E3779B97F4A7C15ULL, positionCounter % 7));
+  }
+  REQUIRE(controller::OpeningBook::write(BOOK_FILE_NAME, 6, 7, 12, 8,
+                                         bookEntries));
+
+  controller::OpeningBook openingBook;
+  REQUIRE_FALSE(openingBook.isOpen());
+  REQUIRE(openingBook.open(BOOK_FILE_NAME, 6, 7));
+  REQUIRE(openingBook.getNumberOfEntries() == bookEntries.size());
+  REQUIRE(openingBook.getSearchDepth() == 12);
+  REQUIRE(openingBook.getNumberOfPlies() == 8);
+
+  for (const std::pair<std::uint64_t, int>& bookEntry : bookEntries)
+  {
+    int move = -1;
+    REQUIRE(openingBook.lookup(bookEntry.first, move));
+    REQUIRE(move == bookEntry.second);
+  }
+
+  int move;
+  REQUIRE_FALSE(openingBook.lookup(12345, move));
+
+  // A book for another board size or a file that is not a book is not used
+  REQUIRE_FALSE(openingBook.open(BOOK_FILE_NAME, 7, 8));
+  REQUIRE_FALSE(openingBook.isOpen());
+  std::ofstream(BOOK_FILE_NAME, std::ios::binary | std::ios::trunc)
+    << "not an opening book";
+  REQUIRE_FALSE(openingBook.open(BOOK_FILE_NAME, 6, 7));
+  REQUIRE_FALSE(openingBook.open("missingOpeningBook.bin", 6, 7));
+
+  std::remove(BOOK_FILE_NAME);
+}
+
+TEST_CASE("gamePlaysOpeningBookMoves", "[openingBook]")
+{
+  // A book that answers a user coin in the center with a coin in the first column
+  model::StandardGameBoard gameBoard;
+  gameBoard.dropCoin(3, true);
+  std::vector<std::pair<std::uint64_t, int> > bookEntries(
+    1, std::make_pair(gameBoard.getPositionHash(), 0));
+  REQUIRE(controller::OpeningBook::write(BOOK_FILE_NAME, 6, 7, 20, 1,
+                                         bookEntries));
+
+  controller::StandardConnectFourGame connectFourGame;
+  REQUIRE(connectFourGame.loadOpeningBook(BOOK_FILE_NAME));
+  connectFourGame.dropCoin(3);
+  REQUIRE(connectFourGame.getGameBoard().getGameBoardVector()[35].hasComputerCoin());
+  REQUIRE(connectFourGame.getDepthReachedForLastMove() == 20);
+  REQUIRE(connectFourGame.getNodesSearchedForLastMove() == 0);
+
+  // Positions that are not in the book are searched
+  connectFourGame.dropCoin(3);
+  REQUIRE(connectFourGame.getDepthReachedForLastMove() == 2);
+  REQUIRE(connectFourGame.getNodesSearchedForLastMove() > 0);
+
+  controller::ConnectFourGame largeGame(7, 8);
+  REQUIRE_FALSE(largeGame.loadOpeningBook(BOOK_FILE_NAME));
+
+  std::remove(BOOK_FILE_NAME);
+}
@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include "PositionAnalysis.hpp"
+
+#include <climits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<controller::PositionAnalysis::Position> readPositions(
+  const char* const lines[], int numberOfLines)
+{
+  std::vector<controller::PositionAnalysis::Position> positions;
+  controller::PositionAnalysis::Position position;
+  for (int lineCounter = 0; lineCounter < numberOfLines; ++lineCounter)
+  {
+    if (controller::PositionAnalysis::readPosition(lines[lineCounter],
+                                                   position))
+    {
+      positions.push_back(position);
+    }
+  }
+  return positions;
+}
+}
+
+TEST_CASE("positionAnalysisScoresEveryColumn", "[positionAnalysis]")
+{
+  // The last position is from the standard benchmark set for the end of the game
+  const char* const lines[] = {"121212 18", "1111111", "89", "   ",
+                               "2252576253462244111563365343671351441 -1"};
+  std::vector<controller::PositionAnalysis::Position> positions =
+    readPositions(lines, 5);
+  REQUIRE(positions.size() == 4);
+  REQUIRE(positions[0].hasExpectedScore);
+  REQUIRE(!positions[1].hasExpectedScore);
+
+  controller::PositionAnalysis::Settings settings;
+  settings.difficultyLevel = 4;
+  controller::PositionAnalysis heuristicAnalysis(settings);
+  controller::PositionAnalysis::Results results =
+    heuristicAnalysis.analyze(positions);
+
+  // A full column and a column that is not on the board make a position invalid
+  REQUIRE(results.validPositions == 2);
+  REQUIRE(!results.analyses[1].isValid);
+  REQUIRE(!results.analyses[2].isValid);
+  REQUIRE(results.analyses[0].bestMove == 0);
+  REQUIRE(results.analyses[0].moveScores[0] == INT_MAX);
+  REQUIRE(results.analyses[3].moveScores[0] == INT_MIN);
+  REQUIRE(results.exactOutcomes == 2);
+  REQUIRE(results.nodesSearched > 0);
+
+  // Exact scores are on the scale of the benchmark sets
+  settings.solveExactly = true;
+  controller::PositionAnalysis exactAnalysis(settings);
+  positions.erase(positions.begin());
+  results = exactAnalysis.analyze(positions);
+  REQUIRE(results.analyses[2].score == -1);
+  REQUIRE(results.analyses[2].bestMove == 5);
+  REQUIRE(results.positionsWithExpectedScore == 1);
+  REQUIRE(results.exactScores == 1);
+
+  std::ostringstream csv, json;
+  exactAnalysis.writeCsv(csv, results);
+  exactAnalysis.writeJson(json, results);
+  REQUIRE(csv.str().find("moves,column1,") == 0);
+  REQUIRE(csv.str().find("1111111,,,,,,,,,,\n") != std::string::npos);
+  REQUIRE(csv.str().find(",,,,,-1,-2,6,-1,-1\n") != std::string::npos);
+  REQUIRE(json.str().find("\"scores\": [null, null, null, null, null, -1, -2],"
+                          " \"bestMove\": 6") != std::string::npos);
+}
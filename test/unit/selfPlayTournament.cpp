@@ -0,0 +1,55 @@
+#include <catch.hpp>
+
+#include "SelfPlayTournament.hpp"
+
+TEST_CASE("selfPlayTournamentCountsEveryGame", "[selfPlayTournament]")
+{
+  controller::SelfPlayTournament::PlayerSettings strongPlayer, weakPlayer;
+  strongPlayer.difficultyLevel = 4;
+  weakPlayer.difficultyLevel = 1;
+  strongPlayer.parallelMode = true;
+
+  controller::SelfPlayTournament tournament(strongPlayer, weakPlayer);
+  tournament.setNumberOfGames(8);
+  tournament.setSeed(7);
+  controller::SelfPlayTournament::Results results = tournament.play();
+
+  REQUIRE(results.gamesPlayed == 8);
+  int gamesWithResult =
+    results.playerOneWins + results.playerTwoWins + results.draws;
+  REQUIRE(gamesWithResult == 8);
+  REQUIRE(results.playerOneWins > results.playerTwoWins);
+  REQUIRE(results.nodesSearched > 0);
+  REQUIRE(results.movesPlayed ==
+          static_cast<long long>(results.moveLatenciesInMilliseconds.size()));
+  REQUIRE(results.getMoveLatencyPercentile(50) <=
+          results.getMoveLatencyPercentile(100));
+
+  //The same seed plays the same games
+  controller::SelfPlayTournament::Results replayedResults = tournament.play();
+  REQUIRE(replayedResults.playerOneWins == results.playerOneWins);
+  REQUIRE(replayedResults.draws == results.draws);
+  REQUIRE(replayedResults.movesPlayed == results.movesPlayed);
+}
+
+TEST_CASE("selfPlayTournamentWithTheSameSeedPlaysTheSameGames",
+          "[selfPlayTournament]")
+{
+  //Serial engines without a time budget search the same nodes whichever
+  //thread plays a game and whichever games it played before
+  controller::SelfPlayTournament::PlayerSettings playerOne, playerTwo;
+  playerOne.difficultyLevel = 4;
+  playerTwo.difficultyLevel = 3;
+
+  controller::SelfPlayTournament tournament(playerOne, playerTwo);
+  tournament.setNumberOfGames(6);
+  tournament.setSeed(11);
+  controller::SelfPlayTournament::Results results = tournament.play();
+  controller::SelfPlayTournament::Results replayedResults = tournament.play();
+
+  REQUIRE(replayedResults.playerOneWins == results.playerOneWins);
+  REQUIRE(replayedResults.playerTwoWins == results.playerTwoWins);
+  REQUIRE(replayedResults.draws == results.draws);
+  REQUIRE(replayedResults.movesPlayed == results.movesPlayed);
+  REQUIRE(replayedResults.nodesSearched == results.nodesSearched);
+}
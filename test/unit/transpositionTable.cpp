@@ -0,0 +1,84 @@
+#include <catch.hpp>
+
+#include "GameBoard.hpp"
+#include "TranspositionTable.hpp"
+
+TEST_CASE("transpositionTableStoresEntries", "[transpositionTable]")
+{
+  controller::TranspositionTable transpositionTable(10);
+  controller::TranspositionTable::Entry entry;
+
+  REQUIRE_FALSE(transpositionTable.lookup(12345, entry));
+
+  entry.depth = 6;
+  entry.boundType = controller::TranspositionTable::BoundType::lowerBound;
+  entry.score = -42;
+  entry.bestMove = 3;
+  transpositionTable.store(12345, entry);
+
+  controller::TranspositionTable::Entry storedEntry;
+  REQUIRE(transpositionTable.lookup(12345, storedEntry));
+  REQUIRE(storedEntry.depth == 6);
+  REQUIRE(storedEntry.boundType ==
+          controller::TranspositionTable::BoundType::lowerBound);
+  REQUIRE(storedEntry.score == -42);
+  REQUIRE(storedEntry.bestMove == 3);
+
+  // A shallower result does not replace a deeper one for the same position
+  entry.depth = 2;
+  entry.score = 7;
+  transpositionTable.store(12345, entry);
+  REQUIRE(transpositionTable.lookup(12345, storedEntry));
+  REQUIRE(storedEntry.score == -42);
+
+  // A different position mapping to the same slot is not mistaken for it
+  REQUIRE_FALSE(transpositionTable.lookup(12345 + 1024, storedEntry));
+}
+
+TEST_CASE("positionHashDependsOnlyOnCoins", "[transpositionTable]")
+{
+  model::GameBoard firstBoard, secondBoard;
+
+  firstBoard.dropCoin(2, true);
+  firstBoard.dropCoin(4, false);
+  firstBoard.dropCoin(3, true);
+
+  secondBoard.dropCoin(3, true);
+  secondBoard.dropCoin(4, false);
+  secondBoard.dropCoin(2, true);
+
+  REQUIRE(firstBoard.getPositionHash() == secondBoard.getPositionHash());
+
+  secondBoard.dropCoin(2, false);
+  REQUIRE(firstBoard.getPositionHash() != secondBoard.getPositionHash());
+}
+
+TEST_CASE("mirroredHashMatchesMirrorImage", "[transpositionTable]")
+{
+  model::GameBoard gameBoard, mirroredBoard;
+
+  gameBoard.dropCoin(0, true);
+  gameBoard.dropCoin(1, false);
+  gameBoard.dropCoin(1, true);
+  mirroredBoard.dropCoin(6, true);
+  mirroredBoard.dropCoin(5, false);
+  mirroredBoard.dropCoin(5, true);
+
+  REQUIRE(gameBoard.getMirroredPositionHash() ==
+          mirroredBoard.getPositionHash());
+  REQUIRE(gameBoard.getPositionHash() ==
+          mirroredBoard.getMirroredPositionHash());
+  REQUIRE_FALSE(gameBoard.isMirrorSymmetric());
+
+  // Coins on both sides in mirrored places make the board its own mirror image
+  gameBoard.dropCoin(6, true);
+  gameBoard.dropCoin(5, false);
+  gameBoard.dropCoin(5, true);
+  REQUIRE(gameBoard.isMirrorSymmetric());
+  REQUIRE(gameBoard.getPositionHash() == gameBoard.getMirroredPositionHash());
+
+  gameBoard.removeCoin(5);
+  REQUIRE_FALSE(gameBoard.isMirrorSymmetric());
+  gameBoard.dropCoin(5, false);
+  REQUIRE_FALSE(gameBoard.isMirrorSymmetric());
+}